@@ -0,0 +1,196 @@
+#include "AddressStrengthReduction.h"
+#include "LoopCanonicalize.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
+
+using namespace llvm;
+
+static cl::opt<unsigned> MaxPointerIVs(
+    "asr-max-pointer-ivs", cl::init(8), cl::Hidden,
+    cl::desc("Max number of pointer induction variables created per loop"));
+
+// Una pointer induction variable condivisa dai GEP con stessa base e stesso step
+struct PointerIV {
+  const SCEV *Start;
+  const SCEVConstant *Step;
+  //Ricorrenza {Start,+,Step} del GEP che ha creato il gruppo
+  const SCEVAddRecExpr *Rec;
+  PHINode *Phi = nullptr;
+  //WeakVH: un GEP può essere eliminato insieme a un altro GEP già ridotto
+  SmallVector<std::pair<WeakVH, const SCEV*>, 4> Users;
+};
+
+// Restituisce la ricorrenza {start,+,step} del GEP se è candidato alla strength reduction
+static const SCEVAddRecExpr *getAddressRecurrence(GetElementPtrInst *GEP, Loop &L, ScalarEvolution &SE) {
+  //Indici tutti costanti o invariant: nulla da ridurre
+  if (GEP->hasAllConstantIndices())
+    return nullptr;
+  bool variantIndex = false;
+  for (Value *Idx : GEP->indices())
+    variantIndex |= !L.isLoopInvariant(Idx);
+  if (!variantIndex)
+    return nullptr;
+
+  auto *AR = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(GEP));
+  if (!AR || AR->getLoop() != &L || !AR->isAffine())
+    return nullptr;
+  if (!isa<SCEVConstant>(AR->getStepRecurrence(SE)) || !SE.isLoopInvariant(AR->getStart(), &L))
+    return nullptr;
+  return AR;
+}
+
+// La IV non torna a un valore già assunto prima dell'uscita: lo garantiscono
+// i flag di no-wrap della ricorrenza oppure il massimo numero di iterazioni,
+// se |step| * max backedge-taken count non supera lo spazio degli indirizzi
+static bool isNeverRepeating(PointerIV &IV, Loop &L, ScalarEvolution &SE) {
+  if (IV.Rec->getNoWrapFlags() != SCEV::FlagAnyWrap)
+    return true;
+  auto *MaxCount = dyn_cast<SCEVConstant>(SE.getConstantMaxBackedgeTakenCount(&L));
+  unsigned bits = SE.getTypeSizeInBits(IV.Step->getType());
+  if (!MaxCount || MaxCount->getAPInt().getActiveBits() > bits)
+    return false;
+  bool overflow;
+  (void)MaxCount->getAPInt().zextOrTrunc(bits).umul_ov(IV.Step->getAPInt().abs(), overflow);
+  return !overflow;
+}
+
+// Riscrive il test di uscita sulla pointer IV (linear function test replacement):
+// il confronto con il limite calcolato nel preheader lascia la IV intera senza usi
+static bool rewriteExitTest(Loop &L, PointerIV &IV, BasicBlock *ExitingBB, const SCEV *ExitCount,
+                            SCEVExpander &Expander, ScalarEvolution &SE) {
+  if (!ExitingBB || isa<SCEVCouldNotCompute>(ExitCount))
+    return false;
+  auto *BI = dyn_cast<BranchInst>(ExitingBB->getTerminator());
+  if (!BI || !BI->isConditional() || !isa<ICmpInst>(BI->getCondition()))
+    return false;
+
+  if (!isNeverRepeating(IV, L, SE))
+    return false;
+
+  //Nel latch è disponibile il valore dopo l'incremento, altrove la PHI
+  BasicBlock *Latch = L.getLoopLatch();
+  bool postIncrement = ExitingBB == Latch;
+  Value *IVValue = postIncrement ? IV.Phi->getIncomingValueForBlock(Latch) : IV.Phi;
+  const SCEVAddRecExpr *Rec = postIncrement ? IV.Rec->getPostIncExpr(SE) : IV.Rec;
+
+  //Valore della IV nell'iterazione in cui il loop esce
+  Type *IndexTy = SE.getEffectiveSCEVType(IV.Rec->getType());
+  if (SE.getTypeSizeInBits(ExitCount->getType()) > SE.getTypeSizeInBits(IndexTy))
+    return false;
+  const SCEV *Limit = Rec->evaluateAtIteration(SE.getNoopOrZeroExtend(ExitCount, IndexTy), SE);
+  Instruction *InsertPt = L.getLoopPreheader()->getTerminator();
+  if (!Expander.isSafeToExpandAt(Limit, InsertPt))
+    return false;
+
+  auto *OldCond = cast<ICmpInst>(BI->getCondition());
+  outs() << "Rewriting exit test --> " << *OldCond << "\n";
+  Value *LimitValue = Expander.expandCodeFor(Limit, IVValue->getType(), InsertPt);
+  //Si resta nel loop finché la IV non raggiunge il limite
+  ICmpInst::Predicate Pred = L.contains(BI->getSuccessor(0)) ? ICmpInst::ICMP_NE : ICmpInst::ICMP_EQ;
+  BI->setCondition(new ICmpInst(BI, Pred, IVValue, LimitValue, "asr.exitcond"));
+  RecursivelyDeleteTriviallyDeadInstructions(OldCond);
+  return true;
+}
+
+PreservedAnalyses AddressStrengthReduction::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  //Verifica che il loop sia in forma normale
+  if (!isInNormalForm(L))
+    return PreservedAnalyses::all();
+
+  ScalarEvolution &SE = LAR.SE;
+  BasicBlock *Preheader = L.getLoopPreheader();
+  BasicBlock *Latch = L.getLoopLatch();
+  BasicBlock *Header = L.getHeader();
+  const DataLayout &DL = Header->getModule()->getDataLayout();
+  SCEVExpander Expander(SE, DL, "asr");
+
+  //Raggruppa i GEP per base e step: i GEP che differiscono solo per un
+  //offset costante condividono la stessa induction variable
+  std::vector<PointerIV> IVs;
+  for (BasicBlock *BB : L.blocks()) {
+    //Solo i blocchi del loop corrente, non dei sottoloop
+    if (LAR.LI.getLoopFor(BB) != &L)
+      continue;
+
+    for (Instruction &I : *BB) {
+      auto *GEP = dyn_cast<GetElementPtrInst>(&I);
+      if (!GEP)
+        continue;
+      const SCEVAddRecExpr *AR = getAddressRecurrence(GEP, L, SE);
+      if (!AR || !Expander.isSafeToExpandAt(AR->getStart(), Preheader->getTerminator()))
+        continue;
+
+      const SCEVConstant *Step = cast<SCEVConstant>(AR->getStepRecurrence(SE));
+      PointerIV *Group = nullptr;
+      for (PointerIV &IV : IVs) {
+        if (IV.Step != Step || SE.getPointerBase(IV.Start) != SE.getPointerBase(AR->getStart()))
+          continue;
+        if (isa<SCEVConstant>(SE.getMinusSCEV(AR->getStart(), IV.Start))) {
+          Group = &IV;
+          break;
+        }
+      }
+
+      if (!Group) {
+        if (IVs.size() >= MaxPointerIVs)
+          continue;
+        IVs.push_back({AR->getStart(), Step, AR});
+        Group = &IVs.back();
+      }
+      Group->Users.push_back({GEP, SE.getMinusSCEV(AR->getStart(), Group->Start)});
+    }
+  }
+
+  if (IVs.empty())
+    return PreservedAnalyses::all();
+
+  //Uscita da riscrivere sulla prima pointer IV, calcolata prima di modificare il loop
+  BasicBlock *ExitingBB = L.getExitingBlock();
+  const SCEV *ExitCount = ExitingBB ? SE.getExitCount(&L, ExitingBB) : SE.getCouldNotCompute();
+
+  SE.forgetLoop(&L);
+  Type *Int8Ty = Type::getInt8Ty(Header->getContext());
+
+  for (PointerIV &IV : IVs) {
+    Type *PtrTy = IV.Start->getType();
+
+    //PHI nell'header: parte dalla base e avanza dello step nel latch
+    Value *Start = Expander.expandCodeFor(IV.Start, PtrTy, Preheader->getTerminator());
+    IV.Phi = PHINode::Create(PtrTy, 2, "asr.iv", &Header->front());
+    Instruction *Next = GetElementPtrInst::Create(Int8Ty, IV.Phi, {IV.Step->getValue()}, "asr.iv.next", Latch->getTerminator());
+    IV.Phi->addIncoming(Start, Preheader);
+    IV.Phi->addIncoming(Next, Latch);
+
+    for (auto &[Handle, Offset] : IV.Users) {
+      if (!Handle)
+        continue;
+      auto *GEP = cast<GetElementPtrInst>(Handle);
+      outs() << "Strength reducing --> " << *GEP << "\n";
+      Value *NewAddress = IV.Phi;
+      //Offset costante rispetto all'induction variable del gruppo
+      if (!Offset->isZero())
+        NewAddress = GetElementPtrInst::Create(Int8Ty, IV.Phi, {cast<SCEVConstant>(Offset)->getValue()}, "asr.addr", GEP);
+      GEP->replaceAllUsesWith(NewAddress);
+      //Elimina il GEP e i calcoli di indice (sext, mul) rimasti senza usi
+      RecursivelyDeleteTriviallyDeadInstructions(GEP);
+    }
+  }
+
+  //Con il test di uscita sulla pointer IV, le IV intere usate solo dal
+  //proprio incremento sono morte: il numero di IV vive non cresce
+  if (rewriteExitTest(L, IVs.front(), ExitingBB, ExitCount, Expander, SE)) {
+    for (PHINode &PN : make_early_inc_range(Header->phis())) {
+      if (PN.getType()->isIntegerTy())
+        RecursivelyDeleteDeadPHINode(&PN);
+    }
+    SE.forgetLoop(&L);
+  }
+
+  return getLoopPassPreservedAnalyses();
+}
@@ -0,0 +1,19 @@
+#ifndef LLVM_TRANSFORMS_ADDRESSSTRENGTHREDUCTION_H
+#define LLVM_TRANSFORMS_ADDRESSSTRENGTHREDUCTION_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Strength reduction degli indirizzi: i GEP calcolati ad ogni iterazione
+	// a partire dalla base (sext + moltiplicazione per lo stride) diventano
+	// induction variable di tipo puntatore incrementate di uno step costante.
+	// Il test di uscita viene riscritto sulla prima di esse, così la IV intera
+	// rimasta senza usi viene eliminata
+	class AddressStrengthReduction : public PassInfoMixin<AddressStrengthReduction> {
+		public:
+		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_ADDRESSSTRENGTHREDUCTION_H
@@ -0,0 +1,22 @@
+#include "ExitValues.h"
+#include "LoopCanonicalize.h"
+#include "LoopDeletion.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+PreservedAnalyses LoopWalkExitValues::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  //Verifica che il loop sia in forma normale
+  if (!isInNormalForm(L))
+    return PreservedAnalyses::all();
+
+  //Riduzioni e induction variable esprimibili in forma chiusa
+  bool Changed = rewriteLoopExitValues(L, LAR, false);
+
+  //Se il loop calcolava solo quei valori non serve più
+  if (Changed)
+    deleteLoopIfDead(L, LAR, LU);
+
+  return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+}
@@ -0,0 +1,16 @@
+#ifndef LLVM_TRANSFORMS_EXITVALUES_H
+#define LLVM_TRANSFORMS_EXITVALUES_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Sostituisce i valori accumulati dal loop e usati dopo l'uscita con la
+	// loro forma chiusa, poi elimina il loop se non resta altro da calcolare
+	class LoopWalkExitValues : public PassInfoMixin<LoopWalkExitValues> {
+		public:
+		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_EXITVALUES_H
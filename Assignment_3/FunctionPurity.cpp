@@ -0,0 +1,144 @@
+#include "FunctionPurity.h"
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/CallGraph.h"
+#include "llvm/Analysis/CFG.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BuildLibCalls.h"
+
+using namespace llvm;
+
+// Verifica se l'accesso in memoria riguarda solo variabili locali (alloca)
+// della funzione, invisibili al chiamante
+static bool isLocalMemoryAccess(Instruction &I) {
+  Value *Ptr = nullptr;
+  if (auto *Load = dyn_cast<LoadInst>(&I)) {
+    if (!Load->isSimple())
+      return false;
+    Ptr = Load->getPointerOperand();
+  }
+  else if (auto *Store = dyn_cast<StoreInst>(&I)) {
+    if (!Store->isSimple())
+      return false;
+    Ptr = Store->getPointerOperand();
+  }
+  else
+    return false;
+
+  return isa<AllocaInst>(getUnderlyingObject(Ptr));
+}
+
+// Analizza un SCC del call graph e aggiunge gli attributi che si possono dimostrare
+static bool inferSCCAttributes(SmallPtrSetImpl<Function*> &SCC) {
+  bool readsMemory = false;
+  bool writesMemory = false;
+  bool mayThrow = false;
+  bool mayNotReturn = false;
+
+  //Un SCC con più funzioni (o una funzione ricorsiva) potrebbe non terminare
+  if (SCC.size() > 1)
+    mayNotReturn = true;
+
+  for (Function *F : SCC) {
+    //Un ciclo nel CFG potrebbe non terminare
+    SmallVector<std::pair<const BasicBlock*, const BasicBlock*>> Backedges;
+    FindFunctionBackedges(*F, Backedges);
+    if (!Backedges.empty())
+      mayNotReturn = true;
+
+    for (BasicBlock &BB : *F) {
+      for (Instruction &I : BB) {
+        if (auto *CB = dyn_cast<CallBase>(&I)) {
+          Function *Callee = CB->getCalledFunction();
+          //Le chiamate interne all'SCC vengono assunte ottimisticamente pure
+          if (Callee && SCC.count(Callee)) {
+            mayNotReturn = true;
+            continue;
+          }
+          if (!CB->doesNotAccessMemory()) {
+            readsMemory = true;
+            if (!CB->onlyReadsMemory())
+              writesMemory = true;
+          }
+          if (CB->mayThrow())
+            mayThrow = true;
+          if (!CB->willReturn())
+            mayNotReturn = true;
+          continue;
+        }
+
+        if (I.mayThrow())
+          mayThrow = true;
+
+        if (!I.mayReadOrWriteMemory() || isLocalMemoryAccess(I))
+          continue;
+        if (I.mayReadFromMemory())
+          readsMemory = true;
+        if (I.mayWriteToMemory())
+          writesMemory = true;
+      }
+    }
+  }
+
+  bool Changed = false;
+  for (Function *F : SCC) {
+    if (!writesMemory) {
+      if (!readsMemory && !F->doesNotAccessMemory()) {
+        F->setDoesNotAccessMemory();
+        outs() << "Function " << F->getName() << " is readnone\n";
+        Changed = true;
+      }
+      else if (readsMemory && !F->onlyReadsMemory()) {
+        F->setOnlyReadsMemory();
+        outs() << "Function " << F->getName() << " is readonly\n";
+        Changed = true;
+      }
+    }
+    if (!mayThrow && !F->doesNotThrow()) {
+      F->setDoesNotThrow();
+      Changed = true;
+    }
+    if (!mayNotReturn && !F->willReturn()) {
+      F->setWillReturn();
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+PreservedAnalyses FunctionPurity::run(Module &M, ModuleAnalysisManager &AM) {
+  CallGraph &CG = AM.getResult<CallGraphAnalysis>(M);
+  FunctionAnalysisManager &FAM = AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+
+  bool Changed = false;
+
+  //Le dichiarazioni di libreria (es. strlen) ricevono gli attributi noti dalla TLI
+  for (Function &F : M) {
+    if (F.isDeclaration() && !F.isIntrinsic())
+      Changed |= inferNonMandatoryLibFuncAttrs(F, FAM.getResult<TargetLibraryAnalysis>(F));
+  }
+
+  //Visita gli SCC del call graph bottom-up: i chiamati prima dei chiamanti
+  for (scc_iterator<CallGraph*> I = scc_begin(&CG); !I.isAtEnd(); ++I) {
+    SmallPtrSet<Function*, 4> SCC;
+    bool analyzable = true;
+
+    for (CallGraphNode *Node : *I) {
+      Function *F = Node->getFunction();
+      //Nodo esterno o funzione senza corpo: nulla da dedurre
+      if (!F || F->isDeclaration() || F->isInterposable()) {
+        analyzable = false;
+        break;
+      }
+      SCC.insert(F);
+    }
+
+    if (analyzable && !SCC.empty())
+      Changed |= inferSCCAttributes(SCC);
+  }
+
+  return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
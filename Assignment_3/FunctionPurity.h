@@ -0,0 +1,17 @@
+#ifndef LLVM_TRANSFORMS_FUNCTIONPURITY_H
+#define LLVM_TRANSFORMS_FUNCTIONPURITY_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/IR/Module.h"
+
+namespace llvm {
+
+	// Inferisce bottom-up sul call graph gli attributi readnone/readonly,
+	// willreturn e nounwind, così che LoopWalk possa spostare le chiamate
+	// loop-invariant a funzioni senza side effect
+	class FunctionPurity : public PassInfoMixin<FunctionPurity> {
+		public:
+		PreservedAnalyses run(Module &M, ModuleAnalysisManager &AM);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_FUNCTIONPURITY_H
@@ -0,0 +1,134 @@
+#include "IVWidening.h"
+#include "LoopCanonicalize.h"
+#include "llvm/Analysis/IVDescriptors.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Local.h"
+
+using namespace llvm;
+
+// Tipo delle sext dell'induction variable: tutte devono estendere allo stesso tipo
+static IntegerType *getWideType(PHINode *Narrow) {
+  IntegerType *WideTy = nullptr;
+  for (User *U : Narrow->users()) {
+    auto *SExt = dyn_cast<SExtInst>(U);
+    if (!SExt)
+      continue;
+    auto *DestTy = dyn_cast<IntegerType>(SExt->getDestTy());
+    if (!DestTy || (WideTy && WideTy != DestTy))
+      return nullptr;
+    WideTy = DestTy;
+  }
+  return WideTy;
+}
+
+// Estende con segno un valore invariant: costante, oppure sext nel preheader
+static Value *sextInvariant(Value *V, IntegerType *WideTy, BasicBlock *Preheader) {
+  if (auto *C = dyn_cast<ConstantInt>(V))
+    return ConstantInt::get(WideTy, C->getValue().sext(WideTy->getBitWidth()));
+  return new SExtInst(V, WideTy, V->getName() + ".wide", Preheader->getTerminator());
+}
+
+// Sostituisce gli usi del valore stretto con quello largo: le sext spariscono,
+// i confronti con segno contro un invariant vengono allargati, il resto usa una trunc
+static void replaceNarrowUses(Instruction *NarrowVal, Instruction *WideVal, Instruction *Skip,
+                              Instruction *TruncPoint, Loop &L, BasicBlock *Preheader) {
+  IntegerType *WideTy = cast<IntegerType>(WideVal->getType());
+  Instruction *Trunc = nullptr;
+
+  for (Use &U : make_early_inc_range(NarrowVal->uses())) {
+    Instruction *UserInst = cast<Instruction>(U.getUser());
+    if (UserInst == Skip)
+      continue;
+
+    if (auto *SExt = dyn_cast<SExtInst>(UserInst)) {
+      if (SExt->getDestTy() == WideTy) {
+        SExt->replaceAllUsesWith(WideVal);
+        SExt->eraseFromParent();
+        continue;
+      }
+    }
+
+    if (auto *Cmp = dyn_cast<ICmpInst>(UserInst)) {
+      unsigned idx = U.getOperandNo();
+      Value *Other = Cmp->getOperand(1 - idx);
+      if ((Cmp->isSigned() || Cmp->isEquality()) && L.isLoopInvariant(Other)) {
+        Cmp->setOperand(1 - idx, sextInvariant(Other, WideTy, Preheader));
+        Cmp->setOperand(idx, WideVal);
+        continue;
+      }
+    }
+
+    if (!Trunc)
+      Trunc = new TruncInst(WideVal, NarrowVal->getType(), NarrowVal->getName() + ".trunc", TruncPoint);
+    U.set(Trunc);
+  }
+}
+
+static bool widenInductionVariable(PHINode *Narrow, Loop &L, ScalarEvolution &SE) {
+  IntegerType *WideTy = getWideType(Narrow);
+  if (!WideTy || WideTy->getBitWidth() <= Narrow->getType()->getIntegerBitWidth())
+    return false;
+
+  InductionDescriptor ID;
+  if (!InductionDescriptor::isInductionPHI(Narrow, &L, &SE, ID) || ID.getKind() != InductionDescriptor::IK_IntInduction)
+    return false;
+
+  ConstantInt *Step = ID.getConstIntStepValue();
+  BasicBlock *Preheader = L.getLoopPreheader();
+  BasicBlock *Latch = L.getLoopLatch();
+
+  //L'incremento deve essere un add nsw dell'induction variable stessa
+  auto *Inc = dyn_cast<BinaryOperator>(Narrow->getIncomingValueForBlock(Latch));
+  if (!Step || !Inc || Inc->getOpcode() != Instruction::Add || !Inc->hasNoSignedWrap() ||
+      (Inc->getOperand(0) != Narrow && Inc->getOperand(1) != Narrow))
+    return false;
+
+  //SCEV deve dimostrare che la sext dell'IV è ancora una ricorrenza (nessun overflow con segno)
+  auto *AR = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(Narrow));
+  if (!AR || AR->getLoop() != &L || !isa<SCEVAddRecExpr>(SE.getSignExtendExpr(AR, WideTy)))
+    return false;
+
+  outs() << "Widening --> " << *Narrow << "\n";
+  SE.forgetLoop(&L);
+
+  //Nuova induction variable larga
+  Value *WideStart = sextInvariant(Narrow->getIncomingValueForBlock(Preheader), WideTy, Preheader);
+  PHINode *WidePhi = PHINode::Create(WideTy, 2, Narrow->getName() + ".wide", Narrow);
+  BinaryOperator *WideInc = BinaryOperator::CreateNSWAdd(
+      WidePhi, ConstantInt::get(WideTy, Step->getValue().sext(WideTy->getBitWidth())),
+      Inc->getName() + ".wide", Inc);
+  WidePhi->addIncoming(WideStart, Preheader);
+  WidePhi->addIncoming(WideInc, Latch);
+
+  replaceNarrowUses(Narrow, WidePhi, Inc, &*L.getHeader()->getFirstInsertionPt(), L, Preheader);
+  replaceNarrowUses(Inc, WideInc, Narrow, WideInc->getNextNode(), L, Preheader);
+
+  //L'IV stretta resta usata solo dal proprio incremento
+  RecursivelyDeleteDeadPHINode(Narrow);
+  return true;
+}
+
+PreservedAnalyses IVWidening::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  //Verifica che il loop sia in forma normale
+  if (!isInNormalForm(L))
+    return PreservedAnalyses::all();
+
+  //Il trip count deve essere limitato
+  if (isa<SCEVCouldNotCompute>(LAR.SE.getBackedgeTakenCount(&L)))
+    return PreservedAnalyses::all();
+
+  SmallVector<PHINode*, 4> Candidates;
+  for (PHINode &PN : L.getHeader()->phis()) {
+    if (PN.getType()->isIntegerTy())
+      Candidates.push_back(&PN);
+  }
+
+  bool Changed = false;
+  for (PHINode *Narrow : Candidates)
+    Changed |= widenInductionVariable(Narrow, L, LAR.SE);
+
+  return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+}
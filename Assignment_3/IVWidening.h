@@ -0,0 +1,16 @@
+#ifndef LLVM_TRANSFORMS_IVWIDENING_H
+#define LLVM_TRANSFORMS_IVWIDENING_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Allarga le induction variable (es. i32 -> i64) quando SCEV dimostra
+	// l'assenza di overflow con segno, eliminando le sext ad ogni iterazione
+	class IVWidening : public PassInfoMixin<IVWidening> {
+		public:
+		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_IVWIDENING_H
@@ -0,0 +1,30 @@
+#include "LoopCanonicalize.h"
+#include "LoopRotate.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+static cl::opt<bool> EnableLoopWalkRotate(
+    "loopwalk-rotate", cl::init(false), cl::Hidden,
+    cl::desc("Rotate loops to bottom-tested form before LoopWalk"));
+
+bool llvm::canonicalizeLoop(Loop &L, LoopStandardAnalysisResults &LAR) {
+  //Preheader, exit block dedicati, latch unico e LCSSA sono già garantiti
+  //dal loop pass adaptor, che esegue LoopSimplify e LCSSA prima dei loop pass
+  if (!L.isLoopSimplifyForm())
+    return false;
+
+  //Rotazione in forma bottom-tested (do-while con guardia)
+  if (EnableLoopWalkRotate && !L.isRotatedForm())
+    return rotateLoop(L, LAR);
+
+  return false;
+}
+
+bool llvm::isInNormalForm(const Loop &L) {
+  if (L.isLoopSimplifyForm())
+    return true;
+  outs() << "Loop not in Normal Form \n";
+  return false;
+}
@@ -0,0 +1,17 @@
+#ifndef LLVM_TRANSFORMS_LOOPCANONICALIZE_H
+#define LLVM_TRANSFORMS_LOOPCANONICALIZE_H
+
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Porta il loop in forma ruotata se richiesto (-loopwalk-rotate). La forma
+	// normale è già garantita dal loop pass adaptor (LoopSimplify e LCSSA).
+	// Restituisce true se la IR è stata modificata
+	bool canonicalizeLoop(Loop &L, LoopStandardAnalysisResults &LAR);
+
+	// Verifica che il loop sia in forma normale (loop-simplify), altrimenti
+	// lo segnala. Controllo comune a tutti i loop pass
+	bool isInNormalForm(const Loop &L);
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_LOOPCANONICALIZE_H
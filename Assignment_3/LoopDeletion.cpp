@@ -0,0 +1,117 @@
+#include "LoopDeletion.h"
+#include "LoopCanonicalize.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
+
+using namespace llvm;
+
+static cl::opt<unsigned> ExitValueBudget(
+    "loopwalk-exit-value-budget", cl::init(8), cl::Hidden,
+    cl::desc("Max cost of a closed-form exit value expanded after the loop"));
+
+bool llvm::rewriteLoopExitValues(Loop &L, LoopStandardAnalysisResults &LAR, bool OnlyInductions) {
+  BasicBlock *Exit = L.getExitBlock();
+  if (!L.getExitingBlock() || !Exit || !L.getLoopPreheader())
+    return false;
+
+  ScalarEvolution &SE = LAR.SE;
+  SCEVExpander Rewriter(SE, Exit->getModule()->getDataLayout(), "loopwalk.exit");
+  bool Changed = false;
+
+  //Con un solo exiting block ogni PHI LCSSA ha un solo ingresso
+  for (PHINode &PN : make_early_inc_range(Exit->phis())) {
+    if (PN.getNumIncomingValues() != 1)
+      continue;
+    auto *Inst = dyn_cast<Instruction>(PN.getIncomingValue(0));
+    if (!Inst || !L.contains(Inst) || !SE.isSCEVable(Inst->getType()))
+      continue;
+
+    //Solo induction variable affini di questo loop, se richiesto
+    const SCEV *S = SE.getSCEV(Inst);
+    auto *AR = dyn_cast<SCEVAddRecExpr>(S);
+    if (OnlyInductions && (!AR || AR->getLoop() != &L || !AR->isAffine()))
+      continue;
+
+    //Valore all'uscita: per le ricorrenze polinomiali (es. somme di i) è la
+    //forma chiusa in funzione del backedge-taken count
+    const SCEV *ExitValue = SE.getSCEVAtScope(S, L.getParentLoop());
+    if (isa<SCEVCouldNotCompute>(ExitValue) || !SE.isLoopInvariant(ExitValue, &L) ||
+        !Rewriter.isSafeToExpand(ExitValue))
+      continue;
+
+    //Calcolarlo una volta non deve costare più del budget
+    if (Rewriter.isHighCostExpansion(ExitValue, &L, ExitValueBudget, &LAR.TTI, Exit->getTerminator()))
+      continue;
+
+    outs() << "Rewriting exit value --> " << PN << "\n";
+    Value *V = Rewriter.expandCodeFor(ExitValue, PN.getType(), &*Exit->getFirstInsertionPt());
+    SE.forgetValue(&PN);
+    PN.replaceAllUsesWith(V);
+    PN.eraseFromParent();
+    Changed = true;
+  }
+  return Changed;
+}
+
+// Il loop non ha effetti osservabili dopo l'uscita e termina sicuramente
+static bool isLoopDead(Loop &L, ScalarEvolution &SE) {
+  BasicBlock *Exit = L.getUniqueExitBlock();
+  if (!Exit || !L.getLoopPreheader() || !L.hasDedicatedExits())
+    return false;
+
+  //Le PHI di uscita ricevono lo stesso valore, definito fuori dal loop
+  for (PHINode &PN : Exit->phis()) {
+    Value *Incoming = PN.getIncomingValue(0);
+    if (!L.isLoopInvariant(Incoming) ||
+        !all_of(PN.incoming_values(), [&](Value *V) { return V == Incoming; }))
+      return false;
+  }
+
+  //Nessun side effect e nessun valore usato fuori dal loop
+  for (BasicBlock *BB : L.blocks()) {
+    for (Instruction &I : *BB) {
+      if (I.mayHaveSideEffects())
+        return false;
+      for (User *U : I.users()) {
+        if (!L.contains(cast<Instruction>(U)))
+          return false;
+      }
+    }
+  }
+
+  //Ogni loop del nido termina (mustprogress o trip count calcolabile)
+  for (Loop *Sub : L.getLoopsInPreorder()) {
+    if (!isMustProgress(Sub) && isa<SCEVCouldNotCompute>(SE.getBackedgeTakenCount(Sub)))
+      return false;
+  }
+  return true;
+}
+
+bool llvm::deleteLoopIfDead(Loop &L, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+  if (!isLoopDead(L, LAR.SE))
+    return false;
+
+  std::string LoopName = std::string(L.getName());
+  outs() << "Deleting loop " << LoopName << "\n";
+  deleteDeadLoop(&L, &LAR.DT, &LAR.SE, &LAR.LI, LAR.MSSA);
+  LU.markLoopAsDeleted(L, LoopName);
+  return true;
+}
+
+PreservedAnalyses LoopWalkDeletion::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  //Verifica che il loop sia in forma normale
+  if (!isInNormalForm(L))
+    return PreservedAnalyses::all();
+
+  //Le induction variable usate dopo il loop diventano valori invarianti
+  bool Changed = rewriteLoopExitValues(L, LAR, true);
+
+  Changed |= deleteLoopIfDead(L, LAR, LU);
+
+  return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+}
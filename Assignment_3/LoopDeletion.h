@@ -0,0 +1,24 @@
+#ifndef LLVM_TRANSFORMS_LOOPDELETION_H
+#define LLVM_TRANSFORMS_LOOPDELETION_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Sostituisce i valori usati dopo il loop con la loro forma chiusa calcolata
+	// da ScalarEvolution (solo induction variable affini se OnlyInductions).
+	// Restituisce true se ha modificato l'IR
+	bool rewriteLoopExitValues(Loop &L, LoopStandardAnalysisResults &LAR, bool OnlyInductions);
+
+	// Elimina il loop se non ha side effect, termina sicuramente e non ha
+	// valori usati dopo l'uscita. Restituisce true se il loop è stato eliminato
+	bool deleteLoopIfDead(Loop &L, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+
+	// Elimina i loop rimasti senza effetti dopo LoopWalk e LoopFusion
+	class LoopWalkDeletion : public PassInfoMixin<LoopWalkDeletion> {
+		public:
+		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_LOOPDELETION_H
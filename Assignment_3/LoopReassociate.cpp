@@ -0,0 +1,112 @@
+#include "LoopReassociate.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+// Verifica se il valore è (o può diventare) loop-invariant: definito fuori dal
+// loop, oppure calcolato nel loop solo a partire da operandi invariant
+static bool isInvariantOperand(Value *V, Loop &L, unsigned depth = 0) {
+  auto *I = dyn_cast<Instruction>(V);
+  if (!I || !L.contains(I->getParent()))
+    return true;
+
+  if (depth > 6 || isa<PHINode>(I) || I->mayReadOrWriteMemory() || I->isTerminator())
+    return false;
+
+  for (Value *op : I->operands()) {
+    if (!isInvariantOperand(op, L, depth + 1))
+      return false;
+  }
+  return true;
+}
+
+// (X op c1) op c2  -->  X op (c1 op c2)
+static bool reassociateBinaryOp(BinaryOperator *I, Loop &L, ScalarEvolution &SE) {
+  unsigned opcode = I->getOpcode();
+  if (!I->getType()->isIntOrIntVectorTy() || !I->isAssociative() || !I->isCommutative())
+    return false;
+
+  for (unsigned i = 0; i < 2; ++i) {
+    Value *c2 = I->getOperand(1 - i);
+    auto *Op = dyn_cast<BinaryOperator>(I->getOperand(i));
+    if (!Op || Op->getOpcode() != opcode || !Op->hasOneUse() || !L.contains(Op->getParent()))
+      continue;
+    if (!isInvariantOperand(c2, L))
+      continue;
+
+    for (unsigned j = 0; j < 2; ++j) {
+      Value *X = Op->getOperand(j);
+      Value *c1 = Op->getOperand(1 - j);
+      if (isInvariantOperand(X, L) || !isInvariantOperand(c1, L))
+        continue;
+
+      outs() << "Reassociating --> " << *I << "\n";
+      SE.forgetValue(I);
+      BinaryOperator *Invariant = BinaryOperator::Create(Instruction::BinaryOps(opcode), c1, c2, "reass", I);
+      I->setOperand(i, X);
+      I->setOperand(1 - i, Invariant);
+      //nsw/nuw non valgono più dopo il riordino
+      I->dropPoisonGeneratingFlags();
+      Op->eraseFromParent();
+      return true;
+    }
+  }
+  return false;
+}
+
+// gep (gep base, X), c  -->  gep (gep base, c), X
+static bool reassociateGEP(GetElementPtrInst *I, Loop &L, ScalarEvolution &SE) {
+  auto *Op = dyn_cast<GetElementPtrInst>(I->getPointerOperand());
+  if (!Op || !Op->hasOneUse() || !L.contains(Op->getParent()))
+    return false;
+  if (I->getNumIndices() != 1 || Op->getNumIndices() != 1 ||
+      I->getSourceElementType() != Op->getSourceElementType())
+    return false;
+
+  Value *Base = Op->getPointerOperand();
+  Value *X = Op->getOperand(1);
+  Value *c = I->getOperand(1);
+  if (!isInvariantOperand(Base, L) || isInvariantOperand(X, L) || !isInvariantOperand(c, L))
+    return false;
+
+  outs() << "Reassociating --> " << *I << "\n";
+  SE.forgetValue(I);
+  GetElementPtrInst *Invariant = GetElementPtrInst::Create(I->getSourceElementType(), Base, {c}, "reass", I);
+  I->setOperand(0, Invariant);
+  I->setOperand(1, X);
+  //inbounds/nusw/nuw non valgono più per gli offset parziali
+  Invariant->setNoWrapFlags(GEPNoWrapFlags::none());
+  I->setNoWrapFlags(GEPNoWrapFlags::none());
+  Op->eraseFromParent();
+  return true;
+}
+
+bool llvm::reassociateLoopInvariants(Loop &L, ScalarEvolution &SE) {
+  bool Changed = false;
+  bool Iterate = true;
+
+  //Ripeti finché le catene non sono completamente riordinate
+  while (Iterate) {
+    Iterate = false;
+    for (BasicBlock *BB : L.blocks()) {
+      for (Instruction &I : *BB) {
+        bool Reassociated = false;
+        if (auto *BinOp = dyn_cast<BinaryOperator>(&I))
+          Reassociated = reassociateBinaryOp(BinOp, L, SE);
+        else if (auto *GEP = dyn_cast<GetElementPtrInst>(&I))
+          Reassociated = reassociateGEP(GEP, L, SE);
+
+        //L'iteratore del blocco non è più valido dopo la cancellazione
+        if (Reassociated) {
+          Changed = Iterate = true;
+          break;
+        }
+      }
+      if (Iterate)
+        break;
+    }
+  }
+  return Changed;
+}
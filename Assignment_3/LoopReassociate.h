@@ -0,0 +1,15 @@
+#ifndef LLVM_TRANSFORMS_LOOPREASSOCIATE_H
+#define LLVM_TRANSFORMS_LOOPREASSOCIATE_H
+
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+
+namespace llvm {
+
+	// Riassocia le catene di operazioni associative e commutative (add, mul,
+	// and, or, xor e offset dei GEP) in modo che gli operandi loop-invariant
+	// formino un sottoalbero separato, che LoopWalk può poi spostare.
+	// Le espressioni riscritte vengono dimenticate da ScalarEvolution
+	bool reassociateLoopInvariants(Loop &L, ScalarEvolution &SE);
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_LOOPREASSOCIATE_H
@@ -0,0 +1,55 @@
+#include "LoopRotate.h"
+#include "LoopCanonicalize.h"
+#include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/Analysis/MemorySSAUpdater.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/LoopRotationUtils.h"
+
+#include <optional>
+
+using namespace llvm;
+
+static cl::opt<unsigned> RotationMaxHeaderSize(
+    "loopwalk-rotation-max-header-size", cl::init(16), cl::Hidden,
+    cl::desc("Max number of header instructions duplicated by loop rotation"));
+
+bool llvm::rotateLoop(Loop &L, LoopInfo &LI, DominatorTree &DT, ScalarEvolution &SE, AssumptionCache &AC,
+                      TargetTransformInfo &TTI, const SimplifyQuery &SQ, MemorySSA *MSSA) {
+  if (!L.isLoopSimplifyForm() || L.isRotatedForm())
+    return false;
+
+  //MemorySSA viene aggiornata se disponibile
+  std::optional<MemorySSAUpdater> MSSAU;
+  if (MSSA)
+    MSSAU.emplace(MSSA);
+
+  //LoopRotation controlla side effect e dimensione dell'header duplicato
+  bool Rotated = LoopRotation(&L, &LI, &TTI, &AC, &DT, &SE, MSSAU ? &*MSSAU : nullptr, SQ,
+                              true, RotationMaxHeaderSize, false);
+  if (Rotated)
+    outs() << "Rotating loop " << L.getHeader()->getName() << "\n";
+  return Rotated;
+}
+
+bool llvm::rotateLoop(Loop &L, LoopStandardAnalysisResults &LAR) {
+  //MemorySSA viene aggiornata se il loop pass manager la mantiene
+  const SimplifyQuery SQ = getBestSimplifyQuery(LAR, L.getHeader()->getModule()->getDataLayout());
+  return rotateLoop(L, LAR.LI, LAR.DT, LAR.SE, LAR.AC, LAR.TTI, SQ, LAR.MSSA);
+}
+
+PreservedAnalyses LoopWalkRotate::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  //Verifica che il loop sia in forma normale
+  if (!isInNormalForm(L))
+    return PreservedAnalyses::all();
+
+  if (!rotateLoop(L, LAR))
+    return PreservedAnalyses::all();
+
+  auto PA = getLoopPassPreservedAnalyses();
+  if (LAR.MSSA)
+    PA.preserve<MemorySSAAnalysis>();
+  return PA;
+}
@@ -0,0 +1,24 @@
+#ifndef LLVM_TRANSFORMS_LOOPROTATE_H
+#define LLVM_TRANSFORMS_LOOPROTATE_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Ruota un loop top-tested in forma do-while con guardia tramite
+	// LoopRotation di LLVM, aggiornando MemorySSA se disponibile.
+	// Restituisce true se il loop è stato ruotato
+	bool rotateLoop(Loop &L, LoopStandardAnalysisResults &LAR);
+
+	// Come sopra, per i pass di funzione che non hanno i risultati del loop pass manager
+	bool rotateLoop(Loop &L, LoopInfo &LI, DominatorTree &DT, ScalarEvolution &SE, AssumptionCache &AC,
+	                TargetTransformInfo &TTI, const SimplifyQuery &SQ, MemorySSA *MSSA = nullptr);
+
+	class LoopWalkRotate : public PassInfoMixin<LoopWalkRotate> {
+		public:
+		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_LOOPROTATE_H
@@ -0,0 +1,310 @@
+#include "LoopUnswitch.h"
+#include "LoopCanonicalize.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/DomTreeUpdater.h"
+#include "llvm/Analysis/LoopIterator.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/Analysis/MemorySSAUpdater.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+
+#include <optional>
+
+using namespace llvm;
+
+static cl::opt<unsigned> UnswitchThreshold(
+    "loopwalk-unswitch-threshold", cl::init(100), cl::Hidden,
+    cl::desc("Max number of instructions duplicated by non-trivial unswitching of a loop and its versions"));
+
+static const char *UnswitchBudgetMD = "llvm.loop.loopwalk.unswitch.budget";
+
+// Istruzioni che si possono ancora duplicare per il loop: il budget è salvato
+// nei metadati del loop e diviso fra le due versioni a ogni unswitching
+static unsigned getUnswitchBudget(Loop &L) {
+  if (MDNode *MD = findOptionMDForLoop(&L, UnswitchBudgetMD))
+    return mdconst::extract<ConstantInt>(MD->getOperand(1))->getZExtValue();
+  return UnswitchThreshold;
+}
+
+static void setUnswitchBudget(Loop &L, unsigned budget) {
+  LLVMContext &Ctx = L.getHeader()->getContext();
+  Metadata *Ops[] = {MDString::get(Ctx, UnswitchBudgetMD),
+                     ConstantAsMetadata::get(ConstantInt::get(Type::getInt32Ty(Ctx), budget))};
+  L.setLoopID(makePostTransformationMetadata(Ctx, L.getLoopID(), {UnswitchBudgetMD}, {MDNode::get(Ctx, Ops)}));
+}
+
+// Rende loop-invariant la condizione del branch spostandola nel preheader se necessario
+static Value *getInvariantCondition(BranchInst *BI, Loop &L, bool &Changed, MemorySSAUpdater *MSSAU) {
+  if (!BI->isConditional())
+    return nullptr;
+
+  Value *Cond = BI->getCondition();
+  if (isa<Constant>(Cond))
+    return nullptr;
+
+  if (!L.makeLoopInvariant(Cond, Changed, L.getLoopPreheader()->getTerminator(), MSSAU))
+    return nullptr;
+
+  return Cond;
+}
+
+// Cerca un branch invariant raggiungibile dall'header senza side effect
+// e con un successore fuori dal loop (unswitching banale)
+static BranchInst *findTrivialBranch(Loop &L) {
+  SmallPtrSet<BasicBlock*, 8> visited;
+  BasicBlock *BB = L.getHeader();
+
+  while (visited.insert(BB).second) {
+    for (Instruction &I : *BB) {
+      if (I.mayHaveSideEffects())
+        return nullptr;
+    }
+
+    auto *BI = dyn_cast<BranchInst>(BB->getTerminator());
+    if (!BI)
+      return nullptr;
+
+    if (BI->isUnconditional()) {
+      BB = BI->getSuccessor(0);
+      if (!L.contains(BB))
+        return nullptr;
+      continue;
+    }
+
+    //Uno dei due successori deve uscire dal loop in un exit block senza PHI
+    for (BasicBlock *Succ : successors(BI)) {
+      if (!L.contains(Succ) && Succ->getUniquePredecessor() == BB && !isa<PHINode>(Succ->begin()))
+        return BI;
+    }
+    return nullptr;
+  }
+  return nullptr;
+}
+
+static void unswitchTrivial(Loop &L, BranchInst *BI, Value *Cond, LoopStandardAnalysisResults &LAR,
+                            MemorySSAUpdater *MSSAU) {
+  BasicBlock *BB = BI->getParent();
+  unsigned exitIdx = L.contains(BI->getSuccessor(0)) ? 1 : 0;
+  BasicBlock *ExitBB = BI->getSuccessor(exitIdx);
+  BasicBlock *LoopSucc = BI->getSuccessor(1 - exitIdx);
+
+  LAR.SE.forgetLoop(&L);
+
+  //Il vecchio preheader diventa il blocco che valuta la condizione
+  BasicBlock *Preheader = L.getLoopPreheader();
+  BasicBlock *NewPreheader = SplitBlock(Preheader, Preheader->getTerminator(), &LAR.DT, &LAR.LI, MSSAU);
+
+  Preheader->getTerminator()->eraseFromParent();
+  if (exitIdx == 0)
+    BranchInst::Create(ExitBB, NewPreheader, Cond, Preheader);
+  else
+    BranchInst::Create(NewPreheader, ExitBB, Cond, Preheader);
+
+  //Dentro il loop il branch diventa incondizionato
+  BI->eraseFromParent();
+  BranchInst::Create(LoopSucc, BB);
+
+  //L'uscita ora parte dal vecchio preheader
+  SmallVector<DominatorTree::UpdateType, 2> Updates = {{DominatorTree::Insert, Preheader, ExitBB},
+                                                         {DominatorTree::Delete, BB, ExitBB}};
+  DomTreeUpdater DTU(LAR.DT, DomTreeUpdater::UpdateStrategy::Eager);
+  DTU.applyUpdates(Updates);
+  if (MSSAU)
+    MSSAU->applyUpdates(Updates, LAR.DT);
+}
+
+// Verifica che, fissato il branch BI in una direzione, il latch resti raggiungibile
+static bool latchReachable(Loop &L, BranchInst *BI, unsigned succIdx) {
+  SmallVector<BasicBlock*> worklist;
+  SmallPtrSet<BasicBlock*, 16> visited;
+  worklist.push_back(L.getHeader());
+
+  while (!worklist.empty()) {
+    BasicBlock *BB = worklist.pop_back_val();
+    if (!L.contains(BB) || !visited.insert(BB).second)
+      continue;
+    if (BB == L.getLoopLatch())
+      return true;
+    if (BB == BI->getParent()) {
+      worklist.push_back(BI->getSuccessor(succIdx));
+      continue;
+    }
+    for (BasicBlock *Succ : successors(BB))
+      worklist.push_back(Succ);
+  }
+  return false;
+}
+
+// Sostituisce il branch condizionale con un salto al successore succIdx
+static void foldBranch(BranchInst *BI, unsigned succIdx, SmallVectorImpl<DominatorTree::UpdateType> &Updates) {
+  BasicBlock *BB = BI->getParent();
+  BasicBlock *Taken = BI->getSuccessor(succIdx);
+  BasicBlock *NotTaken = BI->getSuccessor(1 - succIdx);
+
+  if (NotTaken != Taken) {
+    NotTaken->removePredecessor(BB);
+    Updates.push_back({DominatorTree::Delete, BB, NotTaken});
+  }
+  BI->eraseFromParent();
+  BranchInst::Create(Taken, BB);
+}
+
+static void unswitchNonTrivial(Loop &L, BranchInst *BI, Value *Cond, unsigned budget, LoopStandardAnalysisResults &LAR,
+                               LPMUpdater &LU, MemorySSAUpdater *MSSAU) {
+  LAR.SE.forgetLoop(&L);
+
+  //Il vecchio preheader diventa il blocco che sceglie la versione del loop
+  BasicBlock *Preheader = L.getLoopPreheader();
+  BasicBlock *NewPreheader = SplitBlock(Preheader, Preheader->getTerminator(), &LAR.DT, &LAR.LI, MSSAU);
+
+  SmallVector<BasicBlock*, 8> ExitBlocks;
+  L.getExitBlocks(ExitBlocks);
+
+  //Clona il loop: l'originale esegue il ramo true, la copia il ramo false
+  ValueToValueMapTy VMap;
+  SmallVector<BasicBlock*, 16> NewBlocks;
+  Loop *NewLoop = cloneLoopWithPreheader(NewPreheader, Preheader, &L, VMap, ".us", &LAR.LI, &LAR.DT, NewBlocks);
+  remapInstructionsInBlocks(NewBlocks, VMap);
+
+  //Accessi in memoria della copia, finché VMap associa ogni blocco alla sua copia
+  if (MSSAU) {
+    LoopBlocksRPO RPO(&L);
+    RPO.perform(&LAR.LI);
+    MSSAU->updateForClonedLoop(RPO, ExitBlocks, VMap);
+  }
+
+  //Gli exit block ricevono i valori anche dalla copia (forma LCSSA)
+  for (BasicBlock *Exit : ExitBlocks) {
+    for (PHINode &PN : Exit->phis()) {
+      unsigned numIncoming = PN.getNumIncomingValues();
+      for (unsigned i = 0; i < numIncoming; ++i) {
+        BasicBlock *Incoming = PN.getIncomingBlock(i);
+        if (!L.contains(Incoming))
+          continue;
+        Value *V = PN.getIncomingValue(i);
+        if (Value *Mapped = VMap.lookup(V))
+          V = Mapped;
+        PN.addIncoming(V, cast<BasicBlock>(VMap[Incoming]));
+      }
+    }
+  }
+
+  BasicBlock *ClonePreheader = cast<BasicBlock>(VMap[NewPreheader]);
+  Preheader->getTerminator()->eraseFromParent();
+  BranchInst::Create(NewPreheader, ClonePreheader, Cond, Preheader);
+
+  //Archi nuovi: verso la copia e dalla copia agli exit block
+  SmallVector<DominatorTree::UpdateType, 8> Updates;
+  Updates.push_back({DominatorTree::Insert, Preheader, ClonePreheader});
+  for (BasicBlock *Exit : ExitBlocks) {
+    for (BasicBlock *Pred : predecessors(Exit)) {
+      DominatorTree::UpdateType Update = {DominatorTree::Insert, Pred, Exit};
+      if (NewLoop->contains(Pred) && !is_contained(Updates, Update))
+        Updates.push_back(Update);
+    }
+  }
+
+  BranchInst *ClonedBI = cast<BranchInst>(VMap[BI]);
+  foldBranch(BI, 0, Updates);
+  foldBranch(ClonedBI, 1, Updates);
+
+  DomTreeUpdater DTU(LAR.DT, DomTreeUpdater::UpdateStrategy::Eager);
+  DTU.applyUpdatesPermissive(Updates);
+  if (MSSAU)
+    MSSAU->applyUpdates(Updates, LAR.DT);
+
+  //Elimina i blocchi diventati irraggiungibili nelle due versioni
+  SmallVector<BasicBlock*, 8> DeadBlocks;
+  for (Loop *Version : {&L, NewLoop}) {
+    for (BasicBlock *BB : Version->blocks()) {
+      if (!LAR.DT.isReachableFromEntry(BB))
+        DeadBlocks.push_back(BB);
+    }
+  }
+  for (BasicBlock *BB : DeadBlocks)
+    LAR.LI.removeBlock(BB);
+  if (MSSAU)
+    MSSAU->removeBlocks(SmallSetVector<BasicBlock*, 8>(DeadBlocks.begin(), DeadBlocks.end()));
+  DeleteDeadBlocks(DeadBlocks, &DTU);
+
+  formDedicatedExitBlocks(&L, &LAR.DT, &LAR.LI, MSSAU, true);
+  formDedicatedExitBlocks(NewLoop, &LAR.DT, &LAR.LI, MSSAU, true);
+
+  //Le due versioni si dividono il budget rimasto
+  setUnswitchBudget(L, budget / 2);
+  setUnswitchBudget(*NewLoop, budget / 2);
+
+  LU.addSiblingLoops({NewLoop});
+}
+
+// Analisi preservate: MemorySSA resta valida perché viene aggiornata insieme al CFG
+static PreservedAnalyses getUnswitchPreservedAnalyses(bool Changed, LoopStandardAnalysisResults &LAR) {
+  if (!Changed)
+    return PreservedAnalyses::all();
+  auto PA = getLoopPassPreservedAnalyses();
+  if (LAR.MSSA)
+    PA.preserve<MemorySSAAnalysis>();
+  return PA;
+}
+
+PreservedAnalyses LoopWalkUnswitch::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  //Verifica che il loop sia in forma normale
+  if (!isInNormalForm(L) || !L.isLCSSAForm(LAR.DT))
+    return PreservedAnalyses::all();
+
+  //makeLoopInvariant può spostare istruzioni anche senza unswitching
+  bool Changed = false;
+
+  //MemorySSA viene aggiornata se il loop pass manager la mantiene
+  std::optional<MemorySSAUpdater> MSSAU;
+  if (LAR.MSSA)
+    MSSAU.emplace(LAR.MSSA);
+
+  //Caso banale: il branch invariant porta fuori dal loop
+  if (BranchInst *BI = findTrivialBranch(L)) {
+    if (Value *Cond = getInvariantCondition(BI, L, Changed, MSSAU ? &*MSSAU : nullptr)) {
+      outs() << "Trivial unswitch --> " << *BI << "\n";
+      unswitchTrivial(L, BI, Cond, LAR, MSSAU ? &*MSSAU : nullptr);
+      return getUnswitchPreservedAnalyses(true, LAR);
+    }
+  }
+
+  //Caso non banale: solo loop innermost che si possono duplicare,
+  //entro il budget rimasto al loop originale
+  if (!L.isInnermost() || !L.isSafeToClone())
+    return getUnswitchPreservedAnalyses(Changed, LAR);
+
+  unsigned loopSize = 0;
+  for (BasicBlock *BB : L.blocks())
+    loopSize += BB->size();
+  unsigned budget = getUnswitchBudget(L);
+  if (loopSize > budget)
+    return getUnswitchPreservedAnalyses(Changed, LAR);
+
+  for (BasicBlock *BB : L.blocks()) {
+    auto *BI = dyn_cast<BranchInst>(BB->getTerminator());
+    if (!BI || !BI->isConditional() || BI->getSuccessor(0) == BI->getSuccessor(1))
+      continue;
+    if (!L.contains(BI->getSuccessor(0)) || !L.contains(BI->getSuccessor(1)))
+      continue;
+    //Entrambe le versioni devono restare dei loop
+    if (!latchReachable(L, BI, 0) || !latchReachable(L, BI, 1))
+      continue;
+
+    if (Value *Cond = getInvariantCondition(BI, L, Changed, MSSAU ? &*MSSAU : nullptr)) {
+      outs() << "Non-trivial unswitch --> " << *BI << "\n";
+      unswitchNonTrivial(L, BI, Cond, budget - loopSize, LAR, LU, MSSAU ? &*MSSAU : nullptr);
+      return getUnswitchPreservedAnalyses(true, LAR);
+    }
+  }
+
+  return getUnswitchPreservedAnalyses(Changed, LAR);
+}
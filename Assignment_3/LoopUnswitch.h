@@ -0,0 +1,17 @@
+#ifndef LLVM_TRANSFORMS_LOOPUNSWITCH_H
+#define LLVM_TRANSFORMS_LOOPUNSWITCH_H
+
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Scalar/LoopPassManager.h"
+
+namespace llvm {
+
+	// Unswitching dei branch con condizione loop-invariant: i casi banali
+	// (un successore esce dal loop) spostano il branch nel preheader, gli
+	// altri duplicano il loop entro un budget di dimensione del codice
+	class LoopWalkUnswitch : public PassInfoMixin<LoopWalkUnswitch> {
+		public:
+		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_LOOPUNSWITCH_H
@@ -1,14 +1,82 @@
 #include "LoopWalk.h"
+#include "AddressStrengthReduction.h"
+#include "ExitValues.h"
+#include "FunctionPurity.h"
+#include "IVWidening.h"
+#include "LoopCanonicalize.h"
+#include "LoopDeletion.h"
+#include "LoopReassociate.h"
+#include "LoopRotate.h"
+#include "LoopUnswitch.h"
+#include "SubloopHoist.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Passes/PassPlugin.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/IR/PassManager.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/BranchProbabilityInfo.h"
+#include "llvm/Analysis/LoopIterator.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/MustExecute.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Transforms/Utils/Local.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
 
 
 using namespace llvm;
 
+static cl::opt<bool> LoopWalkRegisterPressure(
+    "loopwalk-register-pressure", cl::init(false), cl::Hidden,
+    cl::desc("Limit LoopWalk hoisting to the registers available on the target"));
+
+static cl::opt<bool> LoopWalkUseBFI(
+    "loopwalk-use-bfi", cl::init(false), cl::Hidden,
+    cl::desc("Use block frequencies for LoopWalk even without profile data"));
+
+static cl::opt<unsigned> LoopWalkSCEVBudget(
+    "loopwalk-scev-budget", cl::init(4), cl::Hidden,
+    cl::desc("Max cost of an invariant SCEV rematerialized in the preheader"));
+
+static cl::opt<std::string> LoopWalkReportFile(
+    "loopwalk-report", cl::init(""), cl::Hidden,
+    cl::desc("Append a JSON-lines report of LoopWalk decisions to this file"));
+
+// Motivo per cui un candidato non viene spostato nel preheader
+enum HoistRejection {
+  NotInvariant,
+  UnsafeMemory,
+  ColdPreheader,
+  NotDominatingUses,
+  NonUniqueDefinition,
+  UsedOutsideNotDominatingExits,
+  RegisterPressure,
+  NumHoistRejections,
+  Hoistable = NumHoistRejections
+};
+
+static const char *HoistRejectionNames[NumHoistRejections] = {
+  "not-invariant", "memory", "cold-preheader", "not-dominating-uses",
+  "non-unique-definition", "used-outside-not-dominating-exits", "register-pressure"
+};
+
+// Contatori raccolti per il report di un loop (solo con -loopwalk-report)
+struct LoopWalkReport {
+  unsigned candidates = 0;
+  unsigned rejected[NumHoistRejections] = {};
+  unsigned hoisted = 0;
+  int64_t cyclesSaved = 0;
+};
 
 bool isLoopInvariant(Instruction &inst, std::set <Instruction*> set, Loop &loop){
 
@@ -117,30 +185,402 @@ bool operandsAlreadyMoved(Instruction* Inst, std::set <Instruction*> set){
   return true;
 }
 
+bool isMemorySafeToHoist(Instruction &inst, Loop &loop, AAResults &AA){
+  //Le istruzioni che non accedono alla memoria si possono sempre spostare
+  if (!inst.mayReadOrWriteMemory())
+    return true;
+
+  //Non spostare store, chiamate con side effect o che potrebbero non terminare
+  if (inst.mayWriteToMemory() || inst.mayThrow() || !inst.willReturn())
+    return false;
+
+  //Solo load e chiamate (readonly) vengono considerate
+  auto *call = dyn_cast<CallBase>(&inst);
+  if (!call && !isa<LoadInst>(inst))
+    return false;
+
+  //Nessuna istruzione del loop deve modificare la memoria letta
+  for (BasicBlock *BB : loop.blocks()) {
+    for (Instruction &other : *BB) {
+      if (!other.mayWriteToMemory())
+        continue;
+
+      ModRefInfo MR = call ? AA.getModRefInfo(&other, call)
+                           : AA.getModRefInfo(&other, MemoryLocation::get(cast<LoadInst>(&inst)));
+      if (isModSet(MR))
+        return false;
+    }
+  }
+  return true;
+}
+
+// Nel preheader una lettura viene eseguita anche quando nel loop non lo sarebbe
+// (ramo non preso, loop con zero iterazioni): deve essere speculabile oppure
+// eseguita sicuramente ogni volta che si entra nel loop
+bool isSafeToExecuteInPreheader(Instruction &inst, Loop &loop, DominatorTree &DT, LoopSafetyInfo &SafetyInfo){
+  if (!inst.mayReadFromMemory())
+    return true;
+  if (isSafeToSpeculativelyExecute(&inst, loop.getLoopPreheader()->getTerminator()))
+    return true;
+  return SafetyInfo.isGuaranteedToExecute(inst, &DT, &loop);
+}
+
+// Costo per iterazione risparmiato spostando l'istruzione fuori dal loop
+int64_t getHoistBenefit(Instruction *Inst, TargetTransformInfo &TTI){
+  InstructionCost Cost = TTI.getInstructionCost(Inst, TargetTransformInfo::TCK_RecipThroughput);
+  if (!Cost.isValid())
+    return 0;
+  return *Cost.getValue();
+}
+
+// Valori vivi attraverso tutto il corpo del loop: valori definiti fuori
+// dal loop e usati dentro, più le PHI dell'header
+void collectLiveAcrossLoop(Loop &L, SmallPtrSetImpl<Value*> &liveValues){
+  for (PHINode &PN : L.getHeader()->phis())
+    liveValues.insert(&PN);
+
+  for (BasicBlock *BB : L.blocks()) {
+    for (Instruction &I : *BB) {
+      for (Value *op : I.operands()) {
+        if (auto *op_inst = dyn_cast<Instruction>(op)) {
+          if (!L.contains(op_inst->getParent()))
+            liveValues.insert(op_inst);
+        }
+        else if (isa<Argument>(op))
+          liveValues.insert(op);
+      }
+    }
+  }
+}
+
+// Valori vivi attraverso il loop usati solo dalle istruzioni spostate:
+// dopo lo spostamento il loro live range finisce nel preheader
+unsigned countFreedLiveValues(Loop &L, SmallPtrSetImpl<Value*> &liveAcross, std::set <Instruction*> &hoisted){
+  unsigned count = 0;
+  for (Value *V : liveAcross) {
+    if (isa<PHINode>(V) && L.contains(cast<Instruction>(V)))
+      continue;
+    bool freed = true;
+    for (User *user : V->users()) {
+      auto *userInst = dyn_cast<Instruction>(user);
+      if (userInst && L.contains(userInst) && !hoisted.count(userInst)) {
+        freed = false;
+        break;
+      }
+    }
+    count += freed;
+  }
+  return count;
+}
+
+// Numero di istruzioni spostate il cui valore resta vivo nel loop (o dopo il loop)
+unsigned countHoistedLiveValues(std::set <Instruction*> &hoisted){
+  unsigned count = 0;
+  for (Instruction *Inst : hoisted) {
+    for (User *user : Inst->users()) {
+      if (auto *userInst = dyn_cast<Instruction>(user)) {
+        if (!hoisted.count(userInst)) {
+          count++;
+          break;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+// Aggiunge a closure l'istruzione e tutti i suoi operandi che devono essere spostati con lei
+void collectHoistClosure(Instruction *Inst, std::set <Instruction*> &candidates, std::set <Instruction*> &closure){
+  if (!closure.insert(Inst).second)
+    return;
+  for (Value *op : Inst->operands()) {
+    if (auto *op_inst = dyn_cast<Instruction>(op)) {
+      if (candidates.count(op_inst))
+        collectHoistClosure(op_inst, candidates, closure);
+    }
+  }
+}
+
+// Se spostare tutti i candidati supera i registri disponibili, sceglie per
+// primi quelli che risparmiano più costo per iterazione e si ferma al limite.
+// I valori liberati dallo spostamento non contano nel limite
+void limitHoistingByRegisterPressure(Loop &L, std::set <Instruction*> &candidates, TargetTransformInfo &TTI){
+  unsigned numRegisters = TTI.getNumberOfRegisters(TTI.getRegisterClassForType(false));
+  SmallPtrSet<Value*, 32> liveAcross;
+  collectLiveAcrossLoop(L, liveAcross);
+  unsigned budget = numRegisters > liveAcross.size() ? numRegisters - liveAcross.size() : 0;
+
+  auto fitsBudget = [&](std::set <Instruction*> &hoisted) {
+    return countHoistedLiveValues(hoisted) <= budget + countFreedLiveValues(L, liveAcross, hoisted);
+  };
+
+  if (fitsBudget(candidates))
+    return;
+
+  //Radici: candidati il cui valore è usato da istruzioni che restano nel loop
+  std::vector<std::pair<Instruction*, int64_t>> roots;
+  for (BasicBlock *BB : L.blocks()) {
+    for (Instruction &I : *BB) {
+      if (!candidates.count(&I))
+        continue;
+      bool isRoot = false;
+      for (User *user : I.users()) {
+        if (auto *userInst = dyn_cast<Instruction>(user))
+          isRoot |= !candidates.count(userInst);
+      }
+      if (!isRoot)
+        continue;
+
+      std::set <Instruction*> closure;
+      collectHoistClosure(&I, candidates, closure);
+      int64_t benefit = 0;
+      for (Instruction *Inst : closure)
+        benefit += getHoistBenefit(Inst, TTI);
+      roots.push_back({&I, benefit});
+    }
+  }
+
+  //Ordina per beneficio decrescente
+  std::stable_sort(roots.begin(), roots.end(), [](auto &A, auto &B) { return A.second > B.second; });
+
+  std::set <Instruction*> selected;
+  for (auto &root : roots) {
+    std::set <Instruction*> tentative = selected;
+    collectHoistClosure(root.first, candidates, tentative);
+    if (fitsBudget(tentative))
+      selected = tentative;
+    else
+      outs() << "Register pressure, not moving --> " << *root.first << "\n";
+  }
+  candidates = selected;
+}
+
+// Restituisce BlockFrequencyInfo se le decisioni devono tenere conto delle frequenze:
+// sempre con dati di profilo (!prof), altrimenti solo con -loopwalk-use-bfi.
+// Senza BFI dal loop pass manager le frequenze vengono calcolate una volta per
+// funzione e ricalcolate solo se il CFG è cambiato: quando lo ha modificato il
+// pass stesso (CFGChanged) o quando un blocco del loop non è noto a BFI
+BlockFrequencyInfo *getLoopWalkBFI(Loop &L, LoopStandardAnalysisResults &LAR, LoopWalkBFICache &Cache,
+                                   bool CFGChanged){
+  Function &F = *L.getHeader()->getParent();
+  if (!F.hasProfileData() && !LoopWalkUseBFI)
+    return nullptr;
+
+  //Disponibile se il loop pass manager è stato creato con BFI
+  if (LAR.BFI)
+    return LAR.BFI;
+
+  //Un blocco creato dopo il calcolo ha frequenza 0, quelli noti almeno 1
+  auto isKnown = [&](BasicBlock *BB) { return Cache.BFI->getBlockFreq(BB).getFrequency() != 0; };
+  bool valid = Cache.BFI && Cache.F == &F && !CFGChanged && isKnown(L.getLoopPreheader());
+  for (BasicBlock *BB : L.blocks()) {
+    if (!valid)
+      break;
+    valid = isKnown(BB);
+  }
+  if (valid)
+    return Cache.BFI.get();
+
+  Cache.F = &F;
+  Cache.BFI.reset();
+  Cache.BPI = std::make_unique<BranchProbabilityInfo>(F, LAR.LI, &LAR.TLI, &LAR.DT);
+  Cache.BFI = std::make_unique<BlockFrequencyInfo>(F, *Cache.BPI, LAR.LI);
+  return Cache.BFI.get();
+}
+
+// Lo spostamento conviene solo se il preheader è eseguito meno spesso del blocco di origine
+bool isColderPreheader(BlockFrequencyInfo *BFI, BasicBlock *Preheader, BasicBlock *Source){
+  if (!BFI)
+    return true;
+  return BFI->getBlockFreq(Preheader) < BFI->getBlockFreq(Source);
+}
+
+// Verifica se l'istruzione dipende (anche indirettamente) da una PHI del loop:
+// sono i casi che isLoopInvariant rifiuta ma che SCEV può dimostrare invariant
+bool dependsOnLoopPHI(Instruction *Inst, Loop &L, unsigned depth = 0){
+  if (isa<PHINode>(Inst))
+    return true;
+  if (depth > 6)
+    return false;
+  for (Value *op : Inst->operands()) {
+    auto *op_inst = dyn_cast<Instruction>(op);
+    if (op_inst && L.contains(op_inst->getParent()) && dependsOnLoopPHI(op_inst, L, depth + 1))
+      return true;
+  }
+  return false;
+}
+
+// Ricalcola nel preheader, tramite SCEVExpander, le espressioni che ScalarEvolution
+// dimostra loop-invariant anche se nascoste dietro PHI (es. i - i + n)
+bool rematerializeSCEVInvariants(Loop &L, LoopStandardAnalysisResults &LAR, BlockFrequencyInfo *BFI){
+  ScalarEvolution &SE = LAR.SE;
+  BasicBlock *Preheader = L.getLoopPreheader();
+  Instruction *insertPoint = Preheader->getTerminator();
+  SCEVExpander Expander(SE, Preheader->getModule()->getDataLayout(), "loopwalk");
+
+  SmallVector<std::pair<Instruction*, const SCEV*>, 8> toRematerialize;
+  for (BasicBlock *BB : L.blocks()) {
+    for (Instruction &Inst : *BB) {
+      if (!SE.isSCEVable(Inst.getType()) || Inst.mayHaveSideEffects() || !dependsOnLoopPHI(&Inst, L))
+        continue;
+
+      const SCEV *S = SE.getSCEV(&Inst);
+      //SCEV opaco per l'istruzione stessa: nessuna informazione in più
+      if (auto *U = dyn_cast<SCEVUnknown>(S)) {
+        if (U->getValue() == &Inst)
+          continue;
+      }
+      if (!SE.isLoopInvariant(S, &L) || !Expander.isSafeToExpandAt(S, insertPoint) ||
+          !isColderPreheader(BFI, Preheader, BB))
+        continue;
+      if (Expander.isHighCostExpansion({S}, &L, LoopWalkSCEVBudget, &LAR.TTI, insertPoint))
+        continue;
+
+      toRematerialize.push_back({&Inst, S});
+    }
+  }
+
+  SmallVector<WeakVH, 8> replaced;
+  for (auto &[Inst, S] : toRematerialize) {
+    outs() << "Rematerializing --> " << *Inst << "\n";
+    Value *V = Expander.expandCodeFor(S, Inst->getType(), insertPoint);
+    SE.forgetValue(Inst);
+    Inst->replaceAllUsesWith(V);
+    replaced.push_back(Inst);
+  }
+
+  //Le istruzioni sostituite (e i loro operandi) ora sono morte
+  for (WeakVH &Handle : replaced) {
+    if (!Handle)
+      continue;
+    if (auto *PN = dyn_cast<PHINode>(Handle))
+      RecursivelyDeleteDeadPHINode(PN);
+    else
+      RecursivelyDeleteTriviallyDeadInstructions(Handle);
+  }
+
+  return !toRematerialize.empty();
+}
+
+// Primo controllo che impedisce di spostare l'istruzione nel preheader,
+// nello stesso ordine in cui vengono valutati per decidere lo spostamento
+HoistRejection classifyHoistCandidate(Instruction &Inst, std::set <Instruction*> &set, Loop &L,
+                                      LoopStandardAnalysisResults &LAR, BlockFrequencyInfo *BFI,
+                                      LoopSafetyInfo &SafetyInfo){
+  if (!isLoopInvariant(Inst, set, L))
+    return NotInvariant;
+  if (!isMemorySafeToHoist(Inst, L, LAR.AA) || !isSafeToExecuteInPreheader(Inst, L, LAR.DT, SafetyInfo))
+    return UnsafeMemory;
+  if (!isColderPreheader(BFI, L.getLoopPreheader(), Inst.getParent()))
+    return ColdPreheader;
+  if (!dominatesAllUses(LAR.DT, &Inst))
+    return NotDominatingUses;
+  if (!isOnlyDefinitionInLoop(L, &Inst))
+    return NonUniqueDefinition;
+  if (!isDeadOutsideLoop(L, &Inst) && !dominatesAllLoopExits(LAR.DT, L, &Inst))
+    return UsedOutsideNotDominatingExits;
+  return Hoistable;
+}
+
+// File di -loopwalk-report, aperto una sola volta per tutto il modulo
+raw_ostream *getLoopWalkReportStream(){
+  static std::unique_ptr<raw_fd_ostream> Stream;
+  static bool Opened = false;
+  if (!Opened) {
+    Opened = true;
+    std::error_code EC;
+    Stream = std::make_unique<raw_fd_ostream>(LoopWalkReportFile, EC, sys::fs::OF_Append | sys::fs::OF_Text);
+    if (EC) {
+      errs() << "Cannot open LoopWalk report " << LoopWalkReportFile << ": " << EC.message() << "\n";
+      Stream.reset();
+    }
+  }
+  return Stream.get();
+}
+
+// Aggiunge una riga JSON con le decisioni prese sul loop al file di -loopwalk-report
+void emitLoopWalkReport(Loop &L, LoopWalkReport &report, StringRef passName){
+  raw_ostream *OS = getLoopWalkReportStream();
+  if (!OS)
+    return;
+
+  BasicBlock *Header = L.getHeader();
+  json::Object rejected;
+  for (unsigned i = 0; i < NumHoistRejections; ++i)
+    rejected[HoistRejectionNames[i]] = report.rejected[i];
+
+  json::Object entry{
+    {"pass", passName},
+    {"function", Header->getParent()->getName()},
+    {"loop", Header->getName()},
+    {"depth", L.getLoopDepth()},
+    {"candidates", report.candidates},
+    {"rejected", std::move(rejected)},
+    {"hoisted", report.hoisted},
+    {"cycles_saved_per_iteration", report.cyclesSaved},
+  };
+
+  //Posizione nel sorgente, se il modulo ha informazioni di debug
+  if (DebugLoc Loc = L.getStartLoc()) {
+    entry["file"] = Loc->getFilename();
+    entry["line"] = Loc.getLine();
+    entry["column"] = Loc.getCol();
+  }
+
+  *OS << json::Value(std::move(entry)) << "\n";
+}
+
 PreservedAnalyses LoopWalk::run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
 
   //Crea un set per tenere traccia delle istruzioni loop-invariant
   std::set <Instruction*> loopInvariantInstructionsSet;
 
+  //Ruota il loop se richiesto (-loopwalk-rotate)
+  bool Changed = canonicalizeLoop(L, LAR);
+
   //Verifica che il loop sia in forma normale
-  if(!L.isLoopSimplifyForm()) {
-  	outs() << "Loop not in Normal Form \n";
-    return PreservedAnalyses::all();
-  }
+  if(!isInNormalForm(L))
+    return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+
+  //Riassocia le espressioni miste per isolare i sottotermini invariant
+  Changed |= reassociateLoopInvariants(L, LAR.SE);
+
+  //Frequenze dei blocchi (profilo PGO o stima statica)
+  BlockFrequencyInfo *BFI = getLoopWalkBFI(L, LAR, BFICache, Changed);
+
+  //Invarianti dimostrati da ScalarEvolution e non visibili a isLoopInvariant
+  Changed |= rematerializeSCEVInvariants(L, LAR, BFI);
+
+  bool reporting = !LoopWalkReportFile.empty();
+  LoopWalkReport report;
+
+  //Blocchi eseguiti sicuramente a ogni ingresso nel loop
+  SimpleLoopSafetyInfo SafetyInfo;
+  SafetyInfo.computeLoopSafetyInfo(&L);
 
    //Per ogni BB per ogni istruzione, verifica se è loop-invariant
   for (Loop::block_iterator BI = L.block_begin(); BI != L.block_end(); ++BI){       
     BasicBlock *BB = *BI;
     for (auto inst = BB->begin(); inst != BB->end(); ++inst ){                      
     Instruction &Inst = *inst;
-    if ( isLoopInvariant(Inst, loopInvariantInstructionsSet, L) &&
-         dominatesAllUses(LAR.DT, &Inst) &&
-         isOnlyDefinitionInLoop(L, &Inst) &&
-         (isDeadOutsideLoop(L, &Inst) || dominatesAllLoopExits(LAR.DT, L, &Inst)) ) {
+    HoistRejection reason = classifyHoistCandidate(Inst, loopInvariantInstructionsSet, L, LAR, BFI, SafetyInfo);
+    if (reason == Hoistable)
         loopInvariantInstructionsSet.insert(&Inst);
+
+    if (reporting && !isa<PHINode>(Inst) && !Inst.isTerminator()) {
+        report.candidates++;
+        if (reason != Hoistable)
+            report.rejected[reason]++;
     }
   }
 }
+  //Limita gli spostamenti ai registri disponibili sul target
+  if (LoopWalkRegisterPressure) {
+    size_t beforeLimit = loopInvariantInstructionsSet.size();
+    limitHoistingByRegisterPressure(L, loopInvariantInstructionsSet, LAR.TTI);
+    report.rejected[RegisterPressure] += beforeLimit - loopInvariantInstructionsSet.size();
+  }
+
   //Ottieni il preheader del loop
   BasicBlock* LoopPreheader = L.getLoopPreheader();
   //Punto di inserimento: prima del terminatore del preheader
@@ -159,13 +599,210 @@ while (!loopInvariantInstructionsSet.empty()) {
     if (toMove.empty()) break;
     for (Instruction* Inst : toMove) {
         outs() << "Moving --> " << *Inst << "\n";
+        if (reporting) {
+            report.hoisted++;
+            report.cyclesSaved += getHoistBenefit(Inst, LAR.TTI);
+        }
         Inst->removeFromParent();
         Inst->insertBefore(insertPoint);
         loopInvariantInstructionsSet.erase(Inst);
+        Changed = true;
     }
 }
 
-  return PreservedAnalyses::all();
+  if (reporting)
+    emitLoopWalkReport(L, report, "LoopWalk");
+
+  return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+}
+
+// Verifica se l'istruzione è loop-invariant rispetto al loop "loop" del nido,
+// considerando come già spostate fuori dal loop le istruzioni assegnate al
+// preheader di un loop (hoistTarget)
+bool isInvariantInNestLevel(Instruction &inst, Loop &loop, DenseMap<Instruction*, Loop*> &hoistTarget){
+
+  //Escludi istruzioni di controllo di flusso e PHI
+  if (inst.getOpcode() == Instruction::Br || inst.getOpcode() == Instruction::ICmp || isa<PHINode>(inst))
+    return false;
+
+  //Per ogni operando
+  for (Value *op : inst.operands()) {
+    Instruction *op_inst = dyn_cast<Instruction>(op);
+    if (!op_inst)
+      continue;
+
+    //Posizione dell'operando dopo gli spostamenti già decisi
+    BasicBlock *opBB = op_inst->getParent();
+    auto target = hoistTarget.find(op_inst);
+    if (target != hoistTarget.end())
+      opBB = target->second->getLoopPreheader();
+
+    //L'operando deve essere definito fuori dal loop
+    if (loop.contains(opBB))
+      return false;
+  }
+  return true;
+}
+
+// Primo controllo che impedisce di spostare l'istruzione nel preheader del
+// loop L del nido (stessi controlli di classifyHoistCandidate)
+HoistRejection classifyNestCandidate(Instruction &Inst, Loop &L, DenseMap<Instruction*, Loop*> &hoistTarget,
+                                     LoopStandardAnalysisResults &LAR, BlockFrequencyInfo *BFI,
+                                     LoopSafetyInfo &SafetyInfo){
+  if (!isInvariantInNestLevel(Inst, L, hoistTarget))
+    return NotInvariant;
+  if (!isMemorySafeToHoist(Inst, L, LAR.AA) || !isSafeToExecuteInPreheader(Inst, L, LAR.DT, SafetyInfo))
+    return UnsafeMemory;
+  if (!isColderPreheader(BFI, L.getLoopPreheader(), Inst.getParent()))
+    return ColdPreheader;
+  if (!dominatesAllUses(LAR.DT, &Inst))
+    return NotDominatingUses;
+  if (!isOnlyDefinitionInLoop(L, &Inst))
+    return NonUniqueDefinition;
+  if (!isDeadOutsideLoop(L, &Inst) && !dominatesAllLoopExits(LAR.DT, L, &Inst))
+    return UsedOutsideNotDominatingExits;
+  return Hoistable;
+}
+
+// Applica limitHoistingByRegisterPressure alle istruzioni destinate al
+// preheader di ciascun loop del nido. Gli usi di un'istruzione che resta al
+// suo posto possono non essere più invariant e restano anch'essi nel loop
+void limitNestHoistingByRegisterPressure(LoopNest &LN, DenseMap<Instruction*, Loop*> &hoistTarget,
+                                         SmallVectorImpl<Instruction*> &hoistOrder,
+                                         DenseMap<Loop*, LoopWalkReport> &reports, LoopStandardAnalysisResults &LAR){
+  for (Loop *L : LN.getLoops()) {
+    std::set <Instruction*> candidates;
+    for (Instruction *Inst : hoistOrder) {
+      if (hoistTarget.lookup(Inst) == L)
+        candidates.insert(Inst);
+    }
+    if (candidates.empty())
+      continue;
+
+    limitHoistingByRegisterPressure(*L, candidates, LAR.TTI);
+    for (Instruction *Inst : hoistOrder) {
+      if (hoistTarget.lookup(Inst) == L && !candidates.count(Inst))
+        hoistTarget.erase(Inst);
+    }
+  }
+
+  //Gli operandi precedono gli usi in hoistOrder: una sola passata basta
+  SmallVector<Instruction*> kept;
+  for (Instruction *Inst : hoistOrder) {
+    auto target = hoistTarget.find(Inst);
+    if (target != hoistTarget.end() && isInvariantInNestLevel(*Inst, *target->second, hoistTarget)) {
+      kept.push_back(Inst);
+      continue;
+    }
+    if (target != hoistTarget.end())
+      hoistTarget.erase(target);
+    reports[LAR.LI.getLoopFor(Inst->getParent())].rejected[RegisterPressure]++;
+  }
+  hoistOrder.assign(kept.begin(), kept.end());
+}
+
+PreservedAnalyses LoopWalkNest::run(LoopNest &LN, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU) {
+
+  Loop &Outermost = LN.getOutermostLoop();
+
+  //Tutti i loop del nido devono essere in forma normale
+  bool Changed = false;
+  for (Loop *L : LN.getLoops()) {
+    Changed |= canonicalizeLoop(*L, LAR);
+    if (!isInNormalForm(*L))
+      return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+  }
+
+  BlockFrequencyInfo *BFI = getLoopWalkBFI(Outermost, LAR, BFICache, Changed);
+
+  //Riassocia le espressioni partendo dai loop più interni
+  for (Loop *L : reverse(LN.getLoops()))
+    Changed |= reassociateLoopInvariants(*L, LAR.SE);
+
+  //Blocchi eseguiti sicuramente a ogni ingresso in ciascun loop del nido
+  DenseMap<Loop*, std::unique_ptr<SimpleLoopSafetyInfo>> safetyInfos;
+  for (Loop *L : LN.getLoops()) {
+    safetyInfos[L] = std::make_unique<SimpleLoopSafetyInfo>();
+    safetyInfos[L]->computeLoopSafetyInfo(L);
+  }
+
+  //Contatori del report per ogni loop del nido (solo con -loopwalk-report)
+  bool reporting = !LoopWalkReportFile.empty();
+  DenseMap<Loop*, LoopWalkReport> reports;
+
+  //Per ogni istruzione da spostare, il loop nel cui preheader verrà inserita
+  DenseMap<Instruction*, Loop*> hoistTarget;
+  //Ordine di spostamento: gli operandi precedono sempre i loro usi
+  SmallVector<Instruction*> hoistOrder;
+
+  //Visita i BB del nido in Reverse Post Order, così ogni definizione
+  //viene analizzata prima dei suoi usi
+  LoopBlocksRPO RPOT(&Outermost);
+  RPOT.perform(&LAR.LI);
+
+  for (BasicBlock *BB : RPOT) {
+    //Catena dei loop che contengono il BB, dal più interno al più esterno
+    SmallVector<Loop*> loopChain;
+    for (Loop *L = LAR.LI.getLoopFor(BB); L; L = L->getParentLoop()) {
+      loopChain.push_back(L);
+      if (L == &Outermost)
+        break;
+    }
+
+    for (Instruction &Inst : *BB) {
+      //Cerca il loop più esterno rispetto al quale l'istruzione è invariant;
+      //se non si sposta, nel report conta il motivo del loop più interno
+      HoistRejection reason = NotInvariant;
+      for (Loop *L : reverse(loopChain)) {
+        reason = classifyNestCandidate(Inst, *L, hoistTarget, LAR, BFI, *safetyInfos[L]);
+        if (reason == Hoistable) {
+          hoistTarget[&Inst] = L;
+          hoistOrder.push_back(&Inst);
+          break;
+        }
+      }
+
+      if (reporting && !isa<PHINode>(Inst) && !Inst.isTerminator()) {
+        LoopWalkReport &report = reports[loopChain.front()];
+        report.candidates++;
+        if (reason != Hoistable)
+          report.rejected[reason]++;
+      }
+    }
+  }
+
+  //Limita gli spostamenti ai registri disponibili sul target, per ogni preheader
+  if (LoopWalkRegisterPressure)
+    limitNestHoistingByRegisterPressure(LN, hoistTarget, hoistOrder, reports, LAR);
+
+  //Sposta ogni istruzione nel preheader del loop scelto
+  for (Instruction *Inst : hoistOrder) {
+    Loop *Source = LAR.LI.getLoopFor(Inst->getParent());
+    BasicBlock *Preheader = hoistTarget[Inst]->getLoopPreheader();
+    outs() << "Moving --> " << *Inst << " to " << Preheader->getName() << "\n";
+    if (reporting) {
+      reports[Source].hoisted++;
+      reports[Source].cyclesSaved += getHoistBenefit(Inst, LAR.TTI);
+    }
+    //Le disposizioni rispetto ai loop del nido cambiano con la posizione
+    LAR.SE.forgetValue(Inst);
+    Inst->removeFromParent();
+    Inst->insertBefore(Preheader->getTerminator());
+  }
+
+  //Trip count ed espressioni dei loop del nido possono dipendere dai valori spostati
+  if (!hoistOrder.empty())
+    LAR.SE.forgetLoop(&Outermost);
+
+  //Una riga per ogni loop del nido, nel punto in cui si trovavano le istruzioni
+  if (reporting) {
+    for (Loop *L : LN.getLoops())
+      emitLoopWalkReport(*L, reports[L], "LoopWalkNest");
+  }
+
+  if (hoistOrder.empty())
+    return Changed ? getLoopPassPreservedAnalyses() : PreservedAnalyses::all();
+  return getLoopPassPreservedAnalyses();
 }
 
 extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo
@@ -180,6 +817,52 @@ llvmGetPassPluginInfo() {
             LPM.addPass(LoopWalk());
             return true;
           }
+          if (Name == "LoopWalkNest") {
+            LPM.addPass(LoopWalkNest());
+            return true;
+          }
+          if (Name == "LoopWalkUnswitch") {
+            LPM.addPass(LoopWalkUnswitch());
+            return true;
+          }
+          if (Name == "AddressStrengthReduction") {
+            LPM.addPass(AddressStrengthReduction());
+            return true;
+          }
+          if (Name == "IVWidening") {
+            LPM.addPass(IVWidening());
+            return true;
+          }
+          if (Name == "LoopWalkRotate") {
+            LPM.addPass(LoopWalkRotate());
+            return true;
+          }
+          if (Name == "LoopWalkDeletion") {
+            LPM.addPass(LoopWalkDeletion());
+            return true;
+          }
+          if (Name == "LoopWalkExitValues") {
+            LPM.addPass(LoopWalkExitValues());
+            return true;
+          }
+          return false;
+        });
+      PB.registerPipelineParsingCallback(
+        [](StringRef Name, FunctionPassManager &FPM,
+           ArrayRef<PassBuilder::PipelineElement>) {
+          if (Name == "LoopWalkHoistSubloops") {
+            FPM.addPass(LoopWalkHoistSubloops());
+            return true;
+          }
+          return false;
+        });
+      PB.registerPipelineParsingCallback(
+        [](StringRef Name, ModulePassManager &MPM,
+           ArrayRef<PassBuilder::PipelineElement>) {
+          if (Name == "FunctionPurity") {
+            MPM.addPass(FunctionPurity());
+            return true;
+          }
           return false;
         });
     }
@@ -3,13 +3,37 @@
 
 #include "llvm/IR/PassManager.h"
 #include "llvm/Transforms/Scalar/LoopPassManager.h"
+#include "llvm/Analysis/LoopNestAnalysis.h"
 #include "llvm/IR/Dominators.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/Analysis/BranchProbabilityInfo.h"
+#include "llvm/IR/ValueHandle.h"
 
 namespace llvm {
+	// Frequenze dei blocchi calcolate una volta per funzione e riusate per
+	// tutti i suoi loop, finché il CFG del loop non cambia
+	struct LoopWalkBFICache {
+		WeakVH F;
+		std::unique_ptr<BranchProbabilityInfo> BPI;
+		std::unique_ptr<BlockFrequencyInfo> BFI;
+	};
+
 	class LoopWalk : public PassInfoMixin<LoopWalk> {
+		LoopWalkBFICache BFICache;
 		public:
 		PreservedAnalyses run(Loop &L, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
 	};
+
+	// Variante nest-aware: sposta ogni istruzione direttamente nel preheader
+	// del loop più esterno del nido rispetto al quale è loop-invariant
+	class LoopWalkNest : public PassInfoMixin<LoopWalkNest> {
+		LoopWalkBFICache BFICache;
+		public:
+		PreservedAnalyses run(LoopNest &LN, LoopAnalysisManager &LAM, LoopStandardAnalysisResults &LAR, LPMUpdater &LU);
+	};
 } // namespace llvm
-#endif // LLVM_TRANSFORMS_LOOPWALK_H
 
+// Load e chiamate readonly si possono spostare se il loop non scrive la memoria letta
+bool isMemorySafeToHoist(llvm::Instruction &inst, llvm::Loop &loop, llvm::AAResults &AA);
+#endif // LLVM_TRANSFORMS_LOOPWALK_H
@@ -0,0 +1,173 @@
+#include "SubloopHoist.h"
+#include "LoopRotate.h"
+#include "LoopWalk.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+using namespace llvm;
+
+// Verifica che il loop interno calcoli gli stessi valori a ogni iterazione
+// del loop esterno e che si possa eseguire una sola volta prima di esso.
+// Con assumeAlwaysExecuted si supponga che sia eseguito a ogni iterazione
+static bool isInvariantSubloop(Loop &Outer, Loop &Sub, LoopInfo &LI, DominatorTree &DT,
+                               ScalarEvolution &SE, AAResults &AA, bool assumeAlwaysExecuted) {
+  if (!Outer.isLoopSimplifyForm() || !Sub.isLoopSimplifyForm() ||
+      !Sub.getExitBlock() || !Outer.contains(Sub.getExitBlock()) ||
+      !Sub.isRecursivelyLCSSAForm(DT, LI))
+    return false;
+
+  //Il loop interno deve terminare
+  if (isa<SCEVCouldNotCompute>(SE.getBackedgeTakenCount(&Sub)))
+    return false;
+
+  //Il loop interno viene eseguito a ogni iterazione del loop esterno?
+  BasicBlock *SubPreheader = Sub.getLoopPreheader();
+  SmallVector<BasicBlock*, 4> OuterExiting;
+  Outer.getExitingBlocks(OuterExiting);
+  bool alwaysExecuted = assumeAlwaysExecuted || all_of(OuterExiting, [&](BasicBlock *BB) {
+    return DT.dominates(SubPreheader, BB);
+  });
+
+  for (BasicBlock *BB : Sub.blocks()) {
+    for (Instruction &I : *BB) {
+      //Niente side effect, la memoria letta non è scritta nel loop esterno
+      if (!isMemorySafeToHoist(I, Outer, AA))
+        return false;
+
+      //Se il loop non è sempre eseguito le istruzioni diventano speculative
+      if (!alwaysExecuted && !I.isTerminator() && !isa<PHINode>(I) &&
+          !isSafeToSpeculativelyExecute(&I))
+        return false;
+
+      //Gli input devono essere definiti fuori dal loop esterno
+      for (Value *Op : I.operands()) {
+        auto *OpInst = dyn_cast<Instruction>(Op);
+        if (OpInst && !Sub.contains(OpInst) && Outer.contains(OpInst))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Loop esterno top-tested (for, while) che esce solo dall'header: il loop
+// interno, eseguito in ogni iterazione, non lo è se il loop esterno fa zero
+// iterazioni. Dopo la rotazione il preheader esterno è dentro la guardia e
+// il loop interno risulta eseguito a ogni iterazione
+static bool isAlwaysExecutedAfterRotation(Loop &Outer, Loop &Sub, DominatorTree &DT) {
+  BasicBlock *Latch = Outer.getLoopLatch();
+  return !Outer.isRotatedForm() && Latch && Outer.getExitingBlock() == Outer.getHeader() &&
+         DT.dominates(Sub.getLoopPreheader(), Latch);
+}
+
+// Il preheader del loop interno deve contenere solo il salto all'header ed
+// essere diverso dall'header esterno: altrimenti se ne crea uno vuoto
+static void formEmptySubloopPreheader(Loop &Outer, Loop &Sub, LoopInfo &LI, DominatorTree &DT) {
+  BasicBlock *SubPreheader = Sub.getLoopPreheader();
+  if (SubPreheader->size() == 1 && SubPreheader->getSinglePredecessor() && SubPreheader != Outer.getHeader())
+    return;
+  SplitEdge(SubPreheader, Sub.getHeader(), &DT, &LI);
+}
+
+// Sposta il loop interno (preheader compreso) fra il preheader del loop
+// esterno e il suo header; il nuovo exit block diventa il preheader esterno
+static void hoistSubloop(Loop &Outer, Loop &Sub, LoopInfo &LI, DominatorTree &DT, ScalarEvolution &SE) {
+  formEmptySubloopPreheader(Outer, Sub, LI, DT);
+
+  BasicBlock *OuterPreheader = Outer.getLoopPreheader();
+  BasicBlock *OuterHeader = Outer.getHeader();
+  BasicBlock *SubPreheader = Sub.getLoopPreheader();
+  BasicBlock *SubPred = SubPreheader->getSinglePredecessor();
+  BasicBlock *SubExit = Sub.getExitBlock();
+  Function *F = OuterHeader->getParent();
+
+  outs() << "Hoisting loop " << Sub.getHeader()->getName() << " out of "
+         << OuterHeader->getName() << "\n";
+
+  SE.forgetLoop(&Outer);
+
+  //Nuovo exit block del loop interno, che entra nel loop esterno
+  BasicBlock *NewExit = BasicBlock::Create(F->getContext(), SubExit->getName() + ".hoisted", F, OuterHeader);
+  BranchInst::Create(OuterHeader, NewExit);
+
+  //Le PHI LCSSA passano nel nuovo exit block
+  for (PHINode &PN : make_early_inc_range(SubExit->phis()))
+    PN.moveBefore(NewExit->getFirstNonPHI());
+
+  SmallVector<BasicBlock*, 4> SubExiting;
+  Sub.getExitingBlocks(SubExiting);
+  for (BasicBlock *BB : SubExiting)
+    BB->getTerminator()->replaceSuccessorWith(SubExit, NewExit);
+
+  //Nel loop esterno si salta direttamente all'exit block originale
+  SubPred->getTerminator()->replaceSuccessorWith(SubPreheader, SubExit);
+
+  //Il preheader esterno entra nel loop interno
+  OuterPreheader->getTerminator()->replaceSuccessorWith(OuterHeader, SubPreheader);
+  for (PHINode &PN : OuterHeader->phis())
+    PN.replaceIncomingBlockWith(OuterPreheader, NewExit);
+
+  //Aggiorna LoopInfo: il loop interno diventa fratello del loop esterno
+  Loop *Parent = Outer.getParentLoop();
+  Outer.removeChildLoop(&Sub);
+  if (Parent)
+    Parent->addChildLoop(&Sub);
+  else
+    LI.addTopLevelLoop(&Sub);
+
+  Outer.removeBlockFromLoop(SubPreheader);
+  for (BasicBlock *BB : Sub.blocks())
+    Outer.removeBlockFromLoop(BB);
+  LI.changeLoopFor(SubPreheader, Parent);
+  if (Parent)
+    Parent->addBasicBlockToLoop(NewExit, LI);
+}
+
+PreservedAnalyses LoopWalkHoistSubloops::run(Function &F, FunctionAnalysisManager &FAM) {
+  LoopInfo &LI = FAM.getResult<LoopAnalysis>(F);
+  DominatorTree &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  ScalarEvolution &SE = FAM.getResult<ScalarEvolutionAnalysis>(F);
+  AAResults &AA = FAM.getResult<AAManager>(F);
+  AssumptionCache &AC = FAM.getResult<AssumptionAnalysis>(F);
+  TargetTransformInfo &TTI = FAM.getResult<TargetIRAnalysis>(F);
+  const SimplifyQuery SQ = getBestSimplifyQuery(FAM, F);
+
+  bool Changed = false;
+
+  //Dai loop più interni verso l'esterno: un loop spostato può risalire ancora
+  for (Loop *Outer : reverse(LI.getLoopsInPreorder())) {
+    SmallVector<Loop*, 4> SubLoops(Outer->getSubLoops().begin(), Outer->getSubLoops().end());
+    for (Loop *Sub : SubLoops) {
+      bool hoistable = isInvariantSubloop(*Outer, *Sub, LI, DT, SE, AA, false);
+
+      //Loop esterno top-tested: lo si ruota in forma do-while con guardia
+      if (!hoistable && isAlwaysExecutedAfterRotation(*Outer, *Sub, DT) &&
+          isInvariantSubloop(*Outer, *Sub, LI, DT, SE, AA, true) && rotateLoop(*Outer, LI, DT, SE, AC, TTI, SQ)) {
+        Changed = true;
+        hoistable = isInvariantSubloop(*Outer, *Sub, LI, DT, SE, AA, false);
+      }
+      if (!hoistable)
+        continue;
+
+      hoistSubloop(*Outer, *Sub, LI, DT, SE);
+      DT.recalculate(F);
+      Changed = true;
+    }
+  }
+
+  if (!Changed)
+    return PreservedAnalyses::all();
+
+  PreservedAnalyses PA;
+  PA.preserve<LoopAnalysis>();
+  PA.preserve<DominatorTreeAnalysis>();
+  return PA;
+}
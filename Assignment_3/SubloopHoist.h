@@ -0,0 +1,17 @@
+#ifndef LLVM_TRANSFORMS_SUBLOOPHOIST_H
+#define LLVM_TRANSFORMS_SUBLOOPHOIST_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+
+	// Sposta interi loop interni loop-invariant (senza side effect, con
+	// input e memoria letta invarianti) davanti al loop che li contiene.
+	// Un loop esterno top-tested viene prima ruotato, così il loop interno
+	// finisce dentro la guardia e non viene eseguito se le iterazioni sono zero
+	class LoopWalkHoistSubloops : public PassInfoMixin<LoopWalkHoistSubloops> {
+		public:
+		PreservedAnalyses run(Function &F, FunctionAnalysisManager &FAM);
+	};
+} // namespace llvm
+#endif // LLVM_TRANSFORMS_SUBLOOPHOIST_H
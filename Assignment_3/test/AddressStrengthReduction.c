@@ -0,0 +1,9 @@
+// Input di AddressStrengthReduction: a[i] e a[i + 1] condividono la stessa
+// pointer induction variable; con -asr-max-pointer-ivs=1 b[i] non viene ridotto
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=AddressStrengthReduction -asr-max-pointer-ivs=1 test/AddressStrengthReduction.ll -o test/AddressStrengthReduction.opt.bc
+//
+void stencil(int *a, int *b, long n) {
+  for (long i = 0; i < n; i++)
+    b[i] = a[i] + a[i + 1];
+}
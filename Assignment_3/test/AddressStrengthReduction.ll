@@ -0,0 +1,31 @@
+; ModuleID = 'test/AddressStrengthReduction.c'
+source_filename = "test/AddressStrengthReduction.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @stencil(ptr noundef %0, ptr noundef %1, i64 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %15, %3
+  %5 = phi i64 [ 0, %3 ], [ %16, %15 ]
+  %6 = icmp slt i64 %5, %2
+  br i1 %6, label %7, label %17
+
+7:                                                ; preds = %4
+  %8 = getelementptr inbounds i32, ptr %0, i64 %5
+  %9 = load i32, ptr %8, align 4
+  %10 = add nsw i64 %5, 1
+  %11 = getelementptr inbounds i32, ptr %0, i64 %10
+  %12 = load i32, ptr %11, align 4
+  %13 = add nsw i32 %9, %12
+  %14 = getelementptr inbounds i32, ptr %1, i64 %5
+  store i32 %13, ptr %14, align 4
+  br label %15
+
+15:                                               ; preds = %7
+  %16 = add nsw i64 %5, 1
+  br label %4
+
+17:                                               ; preds = %4
+  ret void
+}
@@ -0,0 +1,10 @@
+// Input di AddressStrengthReduction con il limite di default: a[i], b[i] e
+// c[i] diventano tre pointer induction variable, il test di uscita i < n
+// viene riscritto sulla IV di a e la IV intera i viene eliminata
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=AddressStrengthReduction test/AddressStrengthReductionIVs.ll -o test/AddressStrengthReductionIVs.opt.bc
+//
+void add(int *a, int *b, int *c, int n) {
+  for (int i = 0; i < n; i++)
+    c[i] = a[i] + b[i];
+}
@@ -0,0 +1,31 @@
+; ModuleID = 'test/AddressStrengthReductionIVs.c'
+source_filename = "test/AddressStrengthReductionIVs.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @add(ptr noundef %0, ptr noundef %1, ptr noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %16, %4
+  %6 = phi i32 [ 0, %4 ], [ %17, %16 ]
+  %7 = icmp slt i32 %6, %3
+  br i1 %7, label %8, label %18
+
+8:                                                ; preds = %5
+  %9 = sext i32 %6 to i64
+  %10 = getelementptr inbounds i32, ptr %0, i64 %9
+  %11 = load i32, ptr %10, align 4
+  %12 = getelementptr inbounds i32, ptr %1, i64 %9
+  %13 = load i32, ptr %12, align 4
+  %14 = add nsw i32 %11, %13
+  %15 = getelementptr inbounds i32, ptr %2, i64 %9
+  store i32 %14, ptr %15, align 4
+  br label %16
+
+16:                                               ; preds = %8
+  %17 = add nsw i32 %6, 1
+  br label %5
+
+18:                                               ; preds = %5
+  ret void
+}
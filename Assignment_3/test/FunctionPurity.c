@@ -0,0 +1,34 @@
+// Input di FunctionPurity + LoopWalk: square è readnone, first e sum sono readonly;
+// b non viene scritto nel loop, quindi square e first vanno nel preheader.
+// sum contiene un loop (potrebbe non terminare) e resta in fill_sum
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes='FunctionPurity,function(loop(LoopWalk))' test/FunctionPurity.ll -o test/FunctionPurity.opt.bc
+//
+int square(int x) {
+  return x * x;
+}
+
+int first(int *v) {
+  return v[0];
+}
+
+int sum(int *v, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += v[i];
+  return s;
+}
+
+void fill(int *restrict a, int *restrict b, int n, int k) {
+  int i = 0;
+  do {
+    a[i] = square(k) + first(b) + i;
+  } while (++i < n);
+}
+
+void fill_sum(int *restrict a, int *restrict b, int n) {
+  int i = 0;
+  do {
+    a[i] = sum(b, n) + i;
+  } while (++i < n);
+}
@@ -0,0 +1,82 @@
+; ModuleID = 'test/FunctionPurity.c'
+source_filename = "test/FunctionPurity.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local i32 @square(i32 noundef %0) {
+  %2 = mul nsw i32 %0, %0
+  ret i32 %2
+}
+
+define dso_local i32 @first(ptr noundef %0) {
+  %2 = load i32, ptr %0, align 4
+  ret i32 %2
+}
+
+define dso_local i32 @sum(ptr noundef %0, i32 noundef %1) {
+  br label %3
+
+3:                                                ; preds = %12, %2
+  %4 = phi i32 [ 0, %2 ], [ %11, %12 ]
+  %5 = phi i32 [ 0, %2 ], [ %13, %12 ]
+  %6 = icmp slt i32 %5, %1
+  br i1 %6, label %7, label %14
+
+7:                                                ; preds = %3
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = add nsw i32 %4, %10
+  br label %12
+
+12:                                               ; preds = %7
+  %13 = add nsw i32 %5, 1
+  br label %3
+
+14:                                               ; preds = %3
+  ret i32 %4
+}
+
+define dso_local void @fill(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %13, %4
+  %6 = phi i32 [ 0, %4 ], [ %14, %13 ]
+  %7 = call i32 @square(i32 noundef %3)
+  %8 = call i32 @first(ptr noundef %1)
+  %9 = add nsw i32 %7, %8
+  %10 = add nsw i32 %9, %6
+  %11 = sext i32 %6 to i64
+  %12 = getelementptr inbounds i32, ptr %0, i64 %11
+  store i32 %10, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %5
+  %14 = add nsw i32 %6, 1
+  %15 = icmp slt i32 %14, %2
+  br i1 %15, label %5, label %16
+
+16:                                               ; preds = %13
+  ret void
+}
+
+define dso_local void @fill_sum(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %10, %3
+  %5 = phi i32 [ 0, %3 ], [ %11, %10 ]
+  %6 = call i32 @sum(ptr noundef %1, i32 noundef %2)
+  %7 = add nsw i32 %6, %5
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  store i32 %7, ptr %9, align 4
+  br label %10
+
+10:                                               ; preds = %4
+  %11 = add nsw i32 %5, 1
+  %12 = icmp slt i32 %11, %2
+  br i1 %12, label %4, label %13
+
+13:                                               ; preds = %10
+  ret void
+}
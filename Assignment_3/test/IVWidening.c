@@ -0,0 +1,11 @@
+// Input di IVWidening: l'induction variable i viene allargata a 64 bit e la
+// sext dell'indice di a[i] sparisce
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=IVWidening test/IVWidening.ll -o test/IVWidening.opt.bc
+//
+int sum(int *a, int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += a[i];
+  return s;
+}
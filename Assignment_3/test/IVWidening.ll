@@ -0,0 +1,28 @@
+; ModuleID = 'test/IVWidening.c'
+source_filename = "test/IVWidening.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local i32 @sum(ptr noundef %0, i32 noundef %1) {
+  br label %3
+
+3:                                                ; preds = %12, %2
+  %4 = phi i32 [ 0, %2 ], [ %11, %12 ]
+  %5 = phi i32 [ 0, %2 ], [ %13, %12 ]
+  %6 = icmp slt i32 %5, %1
+  br i1 %6, label %7, label %14
+
+7:                                                ; preds = %3
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = add nsw i32 %4, %10
+  br label %12
+
+12:                                               ; preds = %7
+  %13 = add nsw i32 %5, 1
+  br label %3
+
+14:                                               ; preds = %3
+  ret i32 %4
+}
@@ -0,0 +1,19 @@
+// Input di LoopWalk con -loopwalk-use-bfi: in rare il ramo con k * k è quasi
+// mai preso e il preheader è più caldo, quindi il prodotto resta nel loop;
+// in often il ramo è quasi sempre preso e il prodotto viene spostato
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalk -loopwalk-use-bfi test/LoopWalkBFI.ll -o test/LoopWalkBFI.opt.bc
+//
+void rare(int *a, int n, int k) {
+  for (int i = 0; i < n; i++) {
+    if (__builtin_expect(a[i] < 0, 0))
+      a[i] = k * k;
+  }
+}
+
+void often(int *a, int n, int k) {
+  for (int i = 0; i < n; i++) {
+    if (__builtin_expect(a[i] < 0, 1))
+      a[i] = k * k;
+  }
+}
@@ -0,0 +1,63 @@
+; ModuleID = 'test/LoopWalkBFI.c'
+source_filename = "test/LoopWalkBFI.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @rare(ptr noundef %0, i32 noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %14, %3
+  %5 = phi i32 [ 0, %3 ], [ %15, %14 ]
+  %6 = icmp slt i32 %5, %1
+  br i1 %6, label %7, label %16
+
+7:                                                ; preds = %4
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = icmp slt i32 %10, 0
+  br i1 %11, label %12, label %14, !prof !0
+
+12:                                               ; preds = %7
+  %13 = mul nsw i32 %2, %2
+  store i32 %13, ptr %9, align 4
+  br label %14
+
+14:                                               ; preds = %12, %7
+  %15 = add nsw i32 %5, 1
+  br label %4
+
+16:                                               ; preds = %4
+  ret void
+}
+
+define dso_local void @often(ptr noundef %0, i32 noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %14, %3
+  %5 = phi i32 [ 0, %3 ], [ %15, %14 ]
+  %6 = icmp slt i32 %5, %1
+  br i1 %6, label %7, label %16
+
+7:                                                ; preds = %4
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %0, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = icmp slt i32 %10, 0
+  br i1 %11, label %12, label %14, !prof !1
+
+12:                                               ; preds = %7
+  %13 = mul nsw i32 %2, %2
+  store i32 %13, ptr %9, align 4
+  br label %14
+
+14:                                               ; preds = %12, %7
+  %15 = add nsw i32 %5, 1
+  br label %4
+
+16:                                               ; preds = %4
+  ret void
+}
+
+!0 = !{!"branch_weights", i32 1, i32 2000}
+!1 = !{!"branch_weights", i32 2000, i32 1}
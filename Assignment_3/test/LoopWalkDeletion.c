@@ -0,0 +1,18 @@
+// Input di LoopWalkDeletion: in count il valore di i all'uscita viene calcolato
+// dopo il loop, che non ha più effetti e viene eliminato; in store il loop
+// scrive in memoria e resta
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkDeletion test/LoopWalkDeletion.ll -o test/LoopWalkDeletion.opt.bc
+//
+int count(int n, int k) {
+  int i;
+  for (i = 0; i < n; i++) {
+    int t = k * 2;
+  }
+  return i;
+}
+
+void store(int *a, int n) {
+  for (int i = 0; i < n; i++)
+    a[i] = i;
+}
@@ -0,0 +1,19 @@
+// Input di LoopWalkExitValues: la somma di triangle diventa la forma chiusa
+// n * (n - 1) / 2 e il loop viene eliminato; la forma chiusa di squares è
+// cubica e supera il budget predefinito, quindi il loop resta
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkExitValues test/LoopWalkExitValues.ll -o test/LoopWalkExitValues.opt.bc
+//
+int triangle(int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += i;
+  return s;
+}
+
+int squares(int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += i * i;
+  return s;
+}
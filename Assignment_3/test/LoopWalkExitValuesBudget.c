@@ -0,0 +1,11 @@
+// Input di LoopWalkExitValues con -loopwalk-exit-value-budget=20: con un budget
+// più alto anche la somma dei quadrati viene calcolata in forma chiusa
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkExitValues -loopwalk-exit-value-budget=20 test/LoopWalkExitValuesBudget.ll -o test/LoopWalkExitValuesBudget.opt.bc
+//
+int squares(int n) {
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += i * i;
+  return s;
+}
@@ -0,0 +1,26 @@
+; ModuleID = 'test/LoopWalkExitValuesBudget.c'
+source_filename = "test/LoopWalkExitValuesBudget.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local i32 @squares(i32 noundef %0) {
+  br label %2
+
+2:                                                ; preds = %9, %1
+  %3 = phi i32 [ 0, %1 ], [ %8, %9 ]
+  %4 = phi i32 [ 0, %1 ], [ %10, %9 ]
+  %5 = icmp slt i32 %4, %0
+  br i1 %5, label %6, label %11
+
+6:                                                ; preds = %2
+  %7 = mul nsw i32 %4, %4
+  %8 = add nsw i32 %3, %7
+  br label %9
+
+9:                                                ; preds = %6
+  %10 = add nsw i32 %4, 1
+  br label %2
+
+11:                                               ; preds = %2
+  ret i32 %3
+}
@@ -0,0 +1,15 @@
+// Input di LoopWalkHoistSubloops: il loop interno somma b senza dipendere da j
+// ed è eseguito a ogni iterazione del loop esterno, quindi viene spostato
+// prima del loop esterno e calcolato una sola volta
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes='loop-simplify,lcssa,LoopWalkHoistSubloops' test/LoopWalkHoistSubloops.ll -o test/LoopWalkHoistSubloops.opt.bc
+//
+void offset(int *restrict a, int *restrict b, int n, int m) {
+  int j = 0;
+  do {
+    int s = 0;
+    for (int k = 0; k < m; k++)
+      s += b[k];
+    a[j] = s + j;
+  } while (++j < n);
+}
@@ -0,0 +1,47 @@
+; ModuleID = 'test/LoopWalkHoistSubloops.c'
+source_filename = "test/LoopWalkHoistSubloops.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @offset(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %23, %4
+  %6 = phi i32 [ 0, %4 ], [ %24, %23 ]
+  br label %7
+
+7:                                                ; preds = %5
+  br label %8
+
+8:                                                ; preds = %17, %7
+  %9 = phi i32 [ 0, %7 ], [ %16, %17 ]
+  %10 = phi i32 [ 0, %7 ], [ %18, %17 ]
+  %11 = icmp slt i32 %10, %3
+  br i1 %11, label %12, label %19
+
+12:                                               ; preds = %8
+  %13 = sext i32 %10 to i64
+  %14 = getelementptr inbounds i32, ptr %1, i64 %13
+  %15 = load i32, ptr %14, align 4
+  %16 = add nsw i32 %9, %15
+  br label %17
+
+17:                                               ; preds = %12
+  %18 = add nsw i32 %10, 1
+  br label %8
+
+19:                                               ; preds = %8
+  %20 = add nsw i32 %9, %6
+  %21 = sext i32 %6 to i64
+  %22 = getelementptr inbounds i32, ptr %0, i64 %21
+  store i32 %20, ptr %22, align 4
+  br label %23
+
+23:                                               ; preds = %19
+  %24 = add nsw i32 %6, 1
+  %25 = icmp slt i32 %24, %2
+  br i1 %25, label %5, label %26
+
+26:                                               ; preds = %23
+  ret void
+}
@@ -0,0 +1,28 @@
+// Input di LoopWalkHoistSubloops con loop esterni top-tested: in offset il
+// loop interno è eseguito in ogni iterazione, quindi il loop esterno viene
+// ruotato e il loop interno spostato nel suo preheader, dentro la guardia
+// n > 0 (con n <= 0 b non viene letto). In offset_odd il loop interno è
+// eseguito solo per j dispari e legge memoria: non viene spostato e il loop
+// esterno non viene ruotato
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes='loop-simplify,lcssa,LoopWalkHoistSubloops' test/LoopWalkHoistSubloopsFor.ll -o test/LoopWalkHoistSubloopsFor.opt.bc
+//
+void offset(int *restrict a, int *restrict b, int n, int m) {
+  for (int j = 0; j < n; j++) {
+    int s = 0;
+    for (int k = 0; k < m; k++)
+      s += b[k];
+    a[j] = s + j;
+  }
+}
+
+void offset_odd(int *restrict a, int *restrict b, int n, int m) {
+  for (int j = 0; j < n; j++) {
+    if (j & 1) {
+      int s = 0;
+      for (int k = 0; k < m; k++)
+        s += b[k];
+      a[j] = s;
+    }
+  }
+}
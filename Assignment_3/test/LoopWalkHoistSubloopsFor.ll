@@ -0,0 +1,97 @@
+; ModuleID = 'test/LoopWalkHoistSubloopsFor.c'
+source_filename = "test/LoopWalkHoistSubloopsFor.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @offset(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %24, %4
+  %6 = phi i32 [ 0, %4 ], [ %25, %24 ]
+  %7 = icmp slt i32 %6, %2
+  br i1 %7, label %8, label %26
+
+8:                                                ; preds = %5
+  br label %9
+
+9:                                                ; preds = %18, %8
+  %10 = phi i32 [ 0, %8 ], [ %17, %18 ]
+  %11 = phi i32 [ 0, %8 ], [ %19, %18 ]
+  %12 = icmp slt i32 %11, %3
+  br i1 %12, label %13, label %20
+
+13:                                               ; preds = %9
+  %14 = sext i32 %11 to i64
+  %15 = getelementptr inbounds i32, ptr %1, i64 %14
+  %16 = load i32, ptr %15, align 4
+  %17 = add nsw i32 %10, %16
+  br label %18
+
+18:                                               ; preds = %13
+  %19 = add nsw i32 %11, 1
+  br label %9
+
+20:                                               ; preds = %9
+  %21 = add nsw i32 %10, %6
+  %22 = sext i32 %6 to i64
+  %23 = getelementptr inbounds i32, ptr %0, i64 %22
+  store i32 %21, ptr %23, align 4
+  br label %24
+
+24:                                               ; preds = %20
+  %25 = add nsw i32 %6, 1
+  br label %5
+
+26:                                               ; preds = %5
+  ret void
+}
+
+define dso_local void @offset_odd(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %27, %4
+  %6 = phi i32 [ 0, %4 ], [ %28, %27 ]
+  %7 = icmp slt i32 %6, %2
+  br i1 %7, label %8, label %29
+
+8:                                                ; preds = %5
+  %9 = and i32 %6, 1
+  %10 = icmp ne i32 %9, 0
+  br i1 %10, label %11, label %26
+
+11:                                               ; preds = %8
+  br label %12
+
+12:                                               ; preds = %21, %11
+  %13 = phi i32 [ 0, %11 ], [ %20, %21 ]
+  %14 = phi i32 [ 0, %11 ], [ %22, %21 ]
+  %15 = icmp slt i32 %14, %3
+  br i1 %15, label %16, label %23
+
+16:                                               ; preds = %12
+  %17 = sext i32 %14 to i64
+  %18 = getelementptr inbounds i32, ptr %1, i64 %17
+  %19 = load i32, ptr %18, align 4
+  %20 = add nsw i32 %13, %19
+  br label %21
+
+21:                                               ; preds = %16
+  %22 = add nsw i32 %14, 1
+  br label %12
+
+23:                                               ; preds = %12
+  %24 = sext i32 %6 to i64
+  %25 = getelementptr inbounds i32, ptr %0, i64 %24
+  store i32 %13, ptr %25, align 4
+  br label %26
+
+26:                                               ; preds = %23, %8
+  br label %27
+
+27:                                               ; preds = %26
+  %28 = add nsw i32 %6, 1
+  br label %5
+
+29:                                               ; preds = %5
+  ret void
+}
@@ -0,0 +1,10 @@
+// Input di LoopWalkNest: n * k è invariante rispetto a entrambi i loop e va
+// nel preheader del loop esterno, i * m solo rispetto al loop interno
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkNest test/LoopWalkNest.ll -o test/LoopWalkNest.opt.bc
+//
+void nest(int n, int m, int k, int *a) {
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < m; j++)
+      a[i * m + j] = n * k + j;
+}
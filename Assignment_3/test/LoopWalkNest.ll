@@ -0,0 +1,45 @@
+; ModuleID = 'test/LoopWalkNest.c'
+source_filename = "test/LoopWalkNest.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @nest(i32 noundef %0, i32 noundef %1, i32 noundef %2, ptr noundef %3) {
+  br label %5
+
+5:                                                ; preds = %22, %4
+  %6 = phi i32 [ 0, %4 ], [ %23, %22 ]
+  %7 = icmp slt i32 %6, %0
+  br i1 %7, label %8, label %24
+
+8:                                                ; preds = %5
+  br label %9
+
+9:                                                ; preds = %19, %8
+  %10 = phi i32 [ 0, %8 ], [ %20, %19 ]
+  %11 = icmp slt i32 %10, %1
+  br i1 %11, label %12, label %21
+
+12:                                               ; preds = %9
+  %13 = mul nsw i32 %0, %2
+  %14 = add nsw i32 %13, %10
+  %15 = mul nsw i32 %6, %1
+  %16 = add nsw i32 %15, %10
+  %17 = sext i32 %16 to i64
+  %18 = getelementptr inbounds i32, ptr %3, i64 %17
+  store i32 %14, ptr %18, align 4
+  br label %19
+
+19:                                               ; preds = %12
+  %20 = add nsw i32 %10, 1
+  br label %9
+
+21:                                               ; preds = %9
+  br label %22
+
+22:                                               ; preds = %21
+  %23 = add nsw i32 %6, 1
+  br label %5
+
+24:                                               ; preds = %5
+  ret void
+}
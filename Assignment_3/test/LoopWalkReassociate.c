@@ -0,0 +1,9 @@
+// Input di LoopWalk con riassociazione: (i + k) + m diventa i + (k + m) e
+// (a + i)[off] diventa (a + off)[i], così k + m e a + off vanno nel preheader
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalk test/LoopWalkReassociate.ll -o test/LoopWalkReassociate.opt.bc
+//
+void shift(int *a, int n, int k, int m, long off) {
+  for (int i = 0; i < n; i++)
+    (a + i)[off] = i + k + m;
+}
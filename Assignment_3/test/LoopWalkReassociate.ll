@@ -0,0 +1,29 @@
+; ModuleID = 'test/LoopWalkReassociate.c'
+source_filename = "test/LoopWalkReassociate.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @shift(ptr noundef %0, i32 noundef %1, i32 noundef %2, i32 noundef %3, i64 noundef %4) {
+  br label %6
+
+6:                                                ; preds = %15, %5
+  %7 = phi i32 [ 0, %5 ], [ %16, %15 ]
+  %8 = icmp slt i32 %7, %1
+  br i1 %8, label %9, label %17
+
+9:                                                ; preds = %6
+  %10 = add nsw i32 %7, %2
+  %11 = add nsw i32 %10, %3
+  %12 = sext i32 %7 to i64
+  %13 = getelementptr inbounds i32, ptr %0, i64 %12
+  %14 = getelementptr inbounds i32, ptr %13, i64 %4
+  store i32 %11, ptr %14, align 4
+  br label %15
+
+15:                                               ; preds = %9
+  %16 = add nsw i32 %7, 1
+  br label %6
+
+17:                                               ; preds = %6
+  ret void
+}
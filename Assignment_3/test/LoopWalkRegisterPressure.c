@@ -0,0 +1,13 @@
+// Input di LoopWalk con -loopwalk-register-pressure: p0..p7 restano vivi nel
+// loop, quindi su x86-64 solo una parte dei prodotti p*7 viene spostata
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalk -loopwalk-register-pressure test/LoopWalkRegisterPressure.ll -o test/LoopWalkRegisterPressure.opt.bc
+//
+void mix(int *a, int n, int p0, int p1, int p2, int p3,
+         int p4, int p5, int p6, int p7) {
+  for (int i = 0; i < n; i++)
+    a[i] = ((p0 * 7 + i) ^ (i - p0)) + ((p1 * 7 + i) ^ (i - p1)) +
+           ((p2 * 7 + i) ^ (i - p2)) + ((p3 * 7 + i) ^ (i - p3)) +
+           ((p4 * 7 + i) ^ (i - p4)) + ((p5 * 7 + i) ^ (i - p5)) +
+           ((p6 * 7 + i) ^ (i - p6)) + ((p7 * 7 + i) ^ (i - p7));
+}
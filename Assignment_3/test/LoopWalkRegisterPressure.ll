@@ -0,0 +1,65 @@
+; ModuleID = 'test/LoopWalkRegisterPressure.c'
+source_filename = "test/LoopWalkRegisterPressure.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @mix(ptr noundef %0, i32 noundef %1, i32 noundef %2, i32 noundef %3, i32 noundef %4, i32 noundef %5, i32 noundef %6, i32 noundef %7, i32 noundef %8, i32 noundef %9) {
+  br label %11
+
+11:                                               ; preds = %56, %10
+  %12 = phi i32 [ 0, %10 ], [ %57, %56 ]
+  %13 = icmp slt i32 %12, %1
+  br i1 %13, label %14, label %58
+
+14:                                               ; preds = %11
+  %15 = mul nsw i32 %2, 7
+  %16 = add nsw i32 %15, %12
+  %17 = sub nsw i32 %12, %2
+  %18 = xor i32 %16, %17
+  %19 = mul nsw i32 %3, 7
+  %20 = add nsw i32 %19, %12
+  %21 = sub nsw i32 %12, %3
+  %22 = xor i32 %20, %21
+  %23 = add nsw i32 %18, %22
+  %24 = mul nsw i32 %4, 7
+  %25 = add nsw i32 %24, %12
+  %26 = sub nsw i32 %12, %4
+  %27 = xor i32 %25, %26
+  %28 = add nsw i32 %23, %27
+  %29 = mul nsw i32 %5, 7
+  %30 = add nsw i32 %29, %12
+  %31 = sub nsw i32 %12, %5
+  %32 = xor i32 %30, %31
+  %33 = add nsw i32 %28, %32
+  %34 = mul nsw i32 %6, 7
+  %35 = add nsw i32 %34, %12
+  %36 = sub nsw i32 %12, %6
+  %37 = xor i32 %35, %36
+  %38 = add nsw i32 %33, %37
+  %39 = mul nsw i32 %7, 7
+  %40 = add nsw i32 %39, %12
+  %41 = sub nsw i32 %12, %7
+  %42 = xor i32 %40, %41
+  %43 = add nsw i32 %38, %42
+  %44 = mul nsw i32 %8, 7
+  %45 = add nsw i32 %44, %12
+  %46 = sub nsw i32 %12, %8
+  %47 = xor i32 %45, %46
+  %48 = add nsw i32 %43, %47
+  %49 = mul nsw i32 %9, 7
+  %50 = add nsw i32 %49, %12
+  %51 = sub nsw i32 %12, %9
+  %52 = xor i32 %50, %51
+  %53 = add nsw i32 %48, %52
+  %54 = sext i32 %12 to i64
+  %55 = getelementptr inbounds i32, ptr %0, i64 %54
+  store i32 %53, ptr %55, align 4
+  br label %56
+
+56:                                               ; preds = %14
+  %57 = add nsw i32 %12, 1
+  br label %11
+
+58:                                               ; preds = %11
+  ret void
+}
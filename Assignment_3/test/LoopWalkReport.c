@@ -0,0 +1,10 @@
+// Input di LoopWalk con -loopwalk-report: k * k viene spostato dal loop interno,
+// poi anche dal loop esterno; il report viene scritto in test/LoopWalkReport.jsonl
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalk -loopwalk-report=test/LoopWalkReport.jsonl test/LoopWalkReport.ll -o test/LoopWalkReport.opt.bc
+//
+void scale(int *a, int n, int m, int k) {
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < m; j++)
+      a[i * m + j] = a[i * m + j] * (k * k);
+}
@@ -0,0 +1,46 @@
+; ModuleID = 'test/LoopWalkReport.c'
+source_filename = "test/LoopWalkReport.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @scale(ptr noundef %0, i32 noundef %1, i32 noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %23, %4
+  %6 = phi i32 [ 0, %4 ], [ %24, %23 ]
+  %7 = icmp slt i32 %6, %1
+  br i1 %7, label %8, label %25
+
+8:                                                ; preds = %5
+  %9 = mul nsw i32 %6, %2
+  br label %10
+
+10:                                               ; preds = %20, %8
+  %11 = phi i32 [ 0, %8 ], [ %21, %20 ]
+  %12 = icmp slt i32 %11, %2
+  br i1 %12, label %13, label %22
+
+13:                                               ; preds = %10
+  %14 = add nsw i32 %9, %11
+  %15 = sext i32 %14 to i64
+  %16 = getelementptr inbounds i32, ptr %0, i64 %15
+  %17 = load i32, ptr %16, align 4
+  %18 = mul nsw i32 %3, %3
+  %19 = mul nsw i32 %17, %18
+  store i32 %19, ptr %16, align 4
+  br label %20
+
+20:                                               ; preds = %13
+  %21 = add nsw i32 %11, 1
+  br label %10
+
+22:                                               ; preds = %10
+  br label %23
+
+23:                                               ; preds = %22
+  %24 = add nsw i32 %6, 1
+  br label %5
+
+25:                                               ; preds = %5
+  ret void
+}
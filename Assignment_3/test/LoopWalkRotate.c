@@ -0,0 +1,17 @@
+// Input di LoopWalkRotate: il loop di fill viene ruotato in forma bottom-tested;
+// in find l'header calcola la condizione con più istruzioni di quante
+// -loopwalk-rotation-max-header-size=4 permette di duplicare e il loop resta com'è
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkRotate -loopwalk-rotation-max-header-size=4 test/LoopWalkRotate.ll -o test/LoopWalkRotate.opt.bc
+//
+void fill(int *a, int n) {
+  for (int i = 0; i < n; i++)
+    a[i] = i;
+}
+
+int find(int *a, int k) {
+  int i = 0;
+  while (a[i] * k + 1 != 0)
+    i++;
+  return i;
+}
@@ -0,0 +1,47 @@
+; ModuleID = 'test/LoopWalkRotate.c'
+source_filename = "test/LoopWalkRotate.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @fill(ptr noundef %0, i32 noundef %1) {
+  br label %3
+
+3:                                                ; preds = %9, %2
+  %4 = phi i32 [ 0, %2 ], [ %10, %9 ]
+  %5 = icmp slt i32 %4, %1
+  br i1 %5, label %6, label %11
+
+6:                                                ; preds = %3
+  %7 = sext i32 %4 to i64
+  %8 = getelementptr inbounds i32, ptr %0, i64 %7
+  store i32 %4, ptr %8, align 4
+  br label %9
+
+9:                                                ; preds = %6
+  %10 = add nsw i32 %4, 1
+  br label %3
+
+11:                                               ; preds = %3
+  ret void
+}
+
+define dso_local i32 @find(ptr noundef %0, i32 noundef %1) {
+  br label %3
+
+3:                                                ; preds = %11, %2
+  %4 = phi i32 [ 0, %2 ], [ %12, %11 ]
+  %5 = sext i32 %4 to i64
+  %6 = getelementptr inbounds i32, ptr %0, i64 %5
+  %7 = load i32, ptr %6, align 4
+  %8 = mul nsw i32 %7, %1
+  %9 = add nsw i32 %8, 1
+  %10 = icmp ne i32 %9, 0
+  br i1 %10, label %11, label %13
+
+11:                                               ; preds = %3
+  %12 = add nsw i32 %4, 1
+  br label %3
+
+13:                                               ; preds = %3
+  ret i32 %4
+}
@@ -0,0 +1,10 @@
+// Input di LoopWalk con -loopwalk-rotate: nel loop top-tested la load di *p
+// non è eseguita sicuramente e resta nel loop; dopo la rotazione il corpo è
+// sempre eseguito e la load va nel preheader
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalk -loopwalk-rotate test/LoopWalkRotateHoist.ll -o test/LoopWalkRotateHoist.opt.bc
+//
+void fill(int *restrict a, int *restrict p, int n) {
+  for (int i = 0; i < n; i++)
+    a[i] = *p;
+}
@@ -0,0 +1,27 @@
+; ModuleID = 'test/LoopWalkRotateHoist.c'
+source_filename = "test/LoopWalkRotateHoist.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @fill(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %11, %3
+  %5 = phi i32 [ 0, %3 ], [ %12, %11 ]
+  %6 = icmp slt i32 %5, %2
+  br i1 %6, label %7, label %13
+
+7:                                                ; preds = %4
+  %8 = load i32, ptr %1, align 4
+  %9 = sext i32 %5 to i64
+  %10 = getelementptr inbounds i32, ptr %0, i64 %9
+  store i32 %8, ptr %10, align 4
+  br label %11
+
+11:                                               ; preds = %7
+  %12 = add nsw i32 %5, 1
+  br label %4
+
+13:                                               ; preds = %4
+  ret void
+}
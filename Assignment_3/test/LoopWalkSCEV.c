@@ -0,0 +1,12 @@
+// Input di LoopWalk con rematerializzazione SCEV: (i + k) - i vale k e non
+// costa nulla; (i * m + k * m) - i * m vale k * m ma con -loopwalk-scev-budget=0
+// la moltiplicazione nel preheader supera il budget e l'espressione resta nel loop
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalk -loopwalk-scev-budget=0 test/LoopWalkSCEV.ll -o test/LoopWalkSCEV.opt.bc
+//
+void fill(int *a, int *b, int n, int k, int m) {
+  for (int i = 0; i < n; i++) {
+    a[i] = (i + k) - i;
+    b[i] = (i * m + k * m) - i * m;
+  }
+}
@@ -0,0 +1,35 @@
+; ModuleID = 'test/LoopWalkSCEV.c'
+source_filename = "test/LoopWalkSCEV.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @fill(ptr noundef %0, ptr noundef %1, i32 noundef %2, i32 noundef %3, i32 noundef %4) {
+  br label %6
+
+6:                                                ; preds = %20, %5
+  %7 = phi i32 [ 0, %5 ], [ %21, %20 ]
+  %8 = icmp slt i32 %7, %2
+  br i1 %8, label %9, label %22
+
+9:                                                ; preds = %6
+  %10 = add nsw i32 %7, %3
+  %11 = sub nsw i32 %10, %7
+  %12 = sext i32 %7 to i64
+  %13 = getelementptr inbounds i32, ptr %0, i64 %12
+  store i32 %11, ptr %13, align 4
+  %14 = mul nsw i32 %7, %4
+  %15 = mul nsw i32 %3, %4
+  %16 = add nsw i32 %14, %15
+  %17 = mul nsw i32 %7, %4
+  %18 = sub nsw i32 %16, %17
+  %19 = getelementptr inbounds i32, ptr %1, i64 %12
+  store i32 %18, ptr %19, align 4
+  br label %20
+
+20:                                               ; preds = %9
+  %21 = add nsw i32 %7, 1
+  br label %6
+
+22:                                               ; preds = %6
+  ret void
+}
@@ -0,0 +1,22 @@
+// Input di LoopWalkUnswitch: in sign il branch su flag viene duplicato
+// (unswitching non banale), in fill il return su stop esce dal loop (banale)
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkUnswitch test/LoopWalkUnswitch.ll -o test/LoopWalkUnswitch.opt.bc
+//
+void sign(int *a, int n, int flag) {
+  for (int i = 0; i < n; i++) {
+    if (flag)
+      a[i] = i;
+    else
+      a[i] = -i;
+  }
+}
+
+void fill(int *a, int n, int stop) {
+  int i = 0;
+  do {
+    if (stop)
+      return;
+    a[i] = i;
+  } while (++i < n);
+}
@@ -0,0 +1,64 @@
+; ModuleID = 'test/LoopWalkUnswitch.c'
+source_filename = "test/LoopWalkUnswitch.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @sign(ptr noundef %0, i32 noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %14, %3
+  %5 = phi i32 [ 0, %3 ], [ %15, %14 ]
+  %6 = icmp slt i32 %5, %1
+  br i1 %6, label %7, label %16
+
+7:                                                ; preds = %4
+  %8 = icmp ne i32 %2, 0
+  %9 = sext i32 %5 to i64
+  %10 = getelementptr inbounds i32, ptr %0, i64 %9
+  br i1 %8, label %11, label %12
+
+11:                                               ; preds = %7
+  store i32 %5, ptr %10, align 4
+  br label %14
+
+12:                                               ; preds = %7
+  %13 = sub nsw i32 0, %5
+  store i32 %13, ptr %10, align 4
+  br label %14
+
+14:                                               ; preds = %12, %11
+  %15 = add nsw i32 %5, 1
+  br label %4
+
+16:                                               ; preds = %4
+  ret void
+}
+
+define dso_local void @fill(ptr noundef %0, i32 noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %11, %3
+  %5 = phi i32 [ 0, %3 ], [ %12, %11 ]
+  %6 = icmp ne i32 %2, 0
+  br i1 %6, label %7, label %8
+
+7:                                                ; preds = %4
+  br label %15
+
+8:                                                ; preds = %4
+  %9 = sext i32 %5 to i64
+  %10 = getelementptr inbounds i32, ptr %0, i64 %9
+  store i32 %5, ptr %10, align 4
+  br label %11
+
+11:                                               ; preds = %8
+  %12 = add nsw i32 %5, 1
+  %13 = icmp slt i32 %12, %1
+  br i1 %13, label %4, label %14
+
+14:                                               ; preds = %11
+  br label %15
+
+15:                                               ; preds = %14, %7
+  ret void
+}
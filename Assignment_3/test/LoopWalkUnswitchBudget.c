@@ -0,0 +1,16 @@
+// Input di LoopWalkUnswitch con budget ridotto: il primo unswitching (su neg)
+// rientra nella soglia, le due versioni ricevono metà del budget rimasto e
+// non possono più duplicarsi per twice
+//
+//	opt -load-pass-plugin=build/LoopWalk.so -passes=LoopWalkUnswitch -loopwalk-unswitch-threshold=20 test/LoopWalkUnswitchBudget.ll -o test/LoopWalkUnswitchBudget.opt.bc
+//
+void scale(int *a, int n, int neg, int twice) {
+  for (int i = 0; i < n; i++) {
+    int v = i;
+    if (neg)
+      v = -i;
+    if (twice)
+      v = v * 2;
+    a[i] = v;
+  }
+}
@@ -0,0 +1,44 @@
+; ModuleID = 'test/LoopWalkUnswitchBudget.c'
+source_filename = "test/LoopWalkUnswitchBudget.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-pc-linux-gnu"
+
+define dso_local void @scale(ptr noundef %0, i32 noundef %1, i32 noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %21, %4
+  %6 = phi i32 [ 0, %4 ], [ %22, %21 ]
+  %7 = icmp slt i32 %6, %1
+  br i1 %7, label %8, label %23
+
+8:                                                ; preds = %5
+  %9 = icmp ne i32 %2, 0
+  br i1 %9, label %10, label %12
+
+10:                                               ; preds = %8
+  %11 = sub nsw i32 0, %6
+  br label %12
+
+12:                                               ; preds = %10, %8
+  %13 = phi i32 [ %11, %10 ], [ %6, %8 ]
+  %14 = icmp ne i32 %3, 0
+  br i1 %14, label %15, label %17
+
+15:                                               ; preds = %12
+  %16 = mul nsw i32 %13, 2
+  br label %17
+
+17:                                               ; preds = %15, %12
+  %18 = phi i32 [ %16, %15 ], [ %13, %12 ]
+  %19 = sext i32 %6 to i64
+  %20 = getelementptr inbounds i32, ptr %0, i64 %19
+  store i32 %18, ptr %20, align 4
+  br label %21
+
+21:                                               ; preds = %17
+  %22 = add nsw i32 %6, 1
+  br label %5
+
+23:                                               ; preds = %5
+  ret void
+}
@@ -0,0 +1,85 @@
+#include "FusionCleanup.h"
+#include "llvm/Analysis/LoopIterator.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/MemorySSAUpdater.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+// Il valore definito da Def può sostituire Use senza rompere la forma LCSSA:
+// Use deve trovarsi nel loop di Def (o in un suo sottoloop)
+static bool isUsableWithoutLCSSA(Instruction *Def, Instruction *Use, LoopInfo &LI) {
+    Loop *DefLoop = LI.getLoopFor(Def->getParent());
+    return !DefLoop || DefLoop->contains(Use);
+}
+
+// Verifica che i due accessi leggano o scrivano esattamente la stessa memoria
+static bool accessSameLocation(Instruction *A, Instruction *B, AAResults &AA) {
+    if (getLoadStoreType(A) != getLoadStoreType(B))
+        return false;
+    if (getLoadStorePointerOperand(A) == getLoadStorePointerOperand(B))
+        return true;
+    return AA.isMustAlias(MemoryLocation::get(A), MemoryLocation::get(B));
+}
+
+bool llvm::eliminateRedundantLoads(Loop *L, LoopInfo &LI, DominatorTree &DT, MemorySSA &MSSA, AAResults &AA) {
+    MemorySSAWalker *Walker = MSSA.getWalker();
+    MemorySSAUpdater Updater(&MSSA);
+
+    // Load già visitati e rimasti, con il loro clobber
+    SmallVector<std::pair<LoadInst*, MemoryAccess*>, 16> available;
+    SmallVector<LoadInst*, 8> deadLoads;
+
+    // In RPO ogni istruzione viene visitata dopo quelle che la dominano
+    LoopBlocksRPO RPO(L);
+    RPO.perform(&LI);
+
+    for (BasicBlock *BB : RPO) {
+        for (Instruction &I : *BB) {
+            auto *Load = dyn_cast<LoadInst>(&I);
+            if (!Load || !Load->isSimple())
+                continue;
+
+            MemoryAccess *Clobber = Walker->getClobberingMemoryAccess(Load);
+
+            //Lo store che scrive per ultimo la stessa memoria nella stessa
+            //iterazione: se è nel loop e domina il load, non viene da un'iterazione precedente
+            if (auto *Def = dyn_cast<MemoryDef>(Clobber)) {
+                auto *Store = dyn_cast_or_null<StoreInst>(Def->getMemoryInst());
+                if (Store && Store->isSimple() && L->contains(Store) && DT.dominates(Store, Load)
+                    && isUsableWithoutLCSSA(Store, Load, LI) && accessSameLocation(Store, Load, AA)) {
+                    outs() << "Forwarding " << *Store << " to " << *Load << "\n";
+                    Load->replaceAllUsesWith(Store->getValueOperand());
+                    deadLoads.push_back(Load);
+                    continue;
+                }
+            }
+
+            //Un load precedente della stessa memoria con lo stesso clobber:
+            //nessuna scrittura fra i due
+            LoadInst *Leader = nullptr;
+            for (auto &[Prev, PrevClobber] : available) {
+                if (PrevClobber == Clobber && DT.dominates(Prev, Load) && isUsableWithoutLCSSA(Prev, Load, LI)
+                    && accessSameLocation(Prev, Load, AA)) {
+                    Leader = Prev;
+                    break;
+                }
+            }
+            if (Leader) {
+                outs() << "Replacing " << *Load << " with " << *Leader << "\n";
+                Load->replaceAllUsesWith(Leader);
+                deadLoads.push_back(Load);
+                continue;
+            }
+
+            available.push_back({Load, Clobber});
+        }
+    }
+
+    for (LoadInst *Load : deadLoads) {
+        Updater.removeMemoryAccess(Load);
+        Load->eraseFromParent();
+    }
+    return !deadLoads.empty();
+}
@@ -0,0 +1,16 @@
+#ifndef LLVM_TRANSFORMS_UTILS_FUSION_CLEANUP_H
+#define LLVM_TRANSFORMS_UTILS_FUSION_CLEANUP_H
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/MemorySSA.h"
+#include "llvm/IR/Dominators.h"
+
+namespace llvm {
+
+	// Pulizia del corpo di un loop fuso: i load ricevono il valore dello store
+	// must-alias della stessa iterazione e i load ripetuti dello stesso
+	// indirizzo vengono sostituiti dal primo. Restituisce true se modifica l'IR
+	bool eliminateRedundantLoads(Loop *L, LoopInfo &LI, DominatorTree &DT, MemorySSA &MSSA, AAResults &AA);
+}
+#endif
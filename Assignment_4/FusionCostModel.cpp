@@ -0,0 +1,108 @@
+#include "FusionCostModel.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+static cl::opt<bool> IgnoreCostModel(
+    "loopfusion-ignore-cost-model", cl::init(false), cl::Hidden,
+    cl::desc("Fuse every legal pair of loops regardless of profitability"));
+
+static cl::opt<unsigned> MaxMemoryStreams(
+    "loopfusion-max-streams", cl::init(16), cl::Hidden,
+    cl::desc("Max number of memory streams a fused loop can keep prefetched"));
+
+// Oggetti sottostanti letti o scritti dal loop
+void collectAccessedObjects(Loop *L, SmallPtrSetImpl<const Value*> &objects) {
+    for (auto *BB : L->blocks()) {
+        for (auto &I : *BB) {
+            if (isa<LoadInst>(I) || isa<StoreInst>(I))
+                objects.insert(getUnderlyingObject(getLoadStorePointerOperand(&I)));
+        }
+    }
+}
+
+// Stima semplice della vettorizzabilità: loop interno, nessuna chiamata
+// (tranne intrinsics) e accessi consecutivi o invarianti. Restituisce la
+// dimensione minima e massima degli elementi acceduti
+bool isLikelyVectorizable(Loop *L, ScalarEvolution &SE, uint64_t &minSize, uint64_t &maxSize) {
+    if (!L->isInnermost())
+        return false;
+
+    const DataLayout &DL = L->getHeader()->getModule()->getDataLayout();
+    minSize = UINT64_MAX;
+    maxSize = 0;
+    for (auto *BB : L->blocks()) {
+        for (auto &I : *BB) {
+            if (isa<CallBase>(I) && !isa<IntrinsicInst>(I))
+                return false;
+            if (!isa<LoadInst>(I) && !isa<StoreInst>(I))
+                continue;
+
+            Type *accessType = getLoadStoreType(&I);
+            uint64_t size = DL.getTypeStoreSize(accessType).getFixedValue();
+            minSize = std::min(minSize, size);
+            maxSize = std::max(maxSize, size);
+
+            //Indirizzo invariante (solo per le load) o consecutivo a ogni iterazione
+            const SCEV *ptr = SE.getSCEV(getLoadStorePointerOperand(&I));
+            if (isa<LoadInst>(I) && SE.isLoopInvariant(ptr, L))
+                continue;
+            auto *AR = dyn_cast<SCEVAddRecExpr>(ptr);
+            auto *step = AR && AR->getLoop() == L && AR->isAffine() ? dyn_cast<SCEVConstant>(AR->getStepRecurrence(SE)) : nullptr;
+            if (!step || step->getAPInt().abs() != size)
+                return false;
+        }
+    }
+    return true;
+}
+
+int llvm::getFusionScore(Loop* l1, Loop* l2, ScalarEvolution &SE) {
+    //Il solo risparmio sull'overhead di controllo non basta: senza riuso dei
+    //dati la fusione allunga il corpo e non guadagna nulla
+    int score = 0;
+
+    //Array usati da entrambi i loop: i dati sono ancora in cache. È l'unico
+    //termine positivo, quindi un punteggio positivo richiede un array condiviso
+    SmallPtrSet<const Value*, 8> l1Objects, l2Objects;
+    collectAccessedObjects(l1, l1Objects);
+    collectAccessedObjects(l2, l2Objects);
+    unsigned shared = 0;
+    for (const Value *object : l2Objects)
+        shared += l1Objects.count(object);
+    score += 2 * shared;
+
+    //Stream contemporanei oltre il limite del prefetcher
+    unsigned streams = l1Objects.size() + l2Objects.size() - shared;
+    if (streams > MaxMemoryStreams)
+        score -= 2 * (streams - MaxMemoryStreams);
+
+    //Vettorizzazione: persa se solo uno dei due loop era vettorizzabile,
+    //ridotta se i tipi degli elementi hanno dimensioni molto diverse
+    uint64_t min1, max1, min2, max2;
+    bool vec1 = isLikelyVectorizable(l1, SE, min1, max1);
+    bool vec2 = isLikelyVectorizable(l2, SE, min2, max2);
+    if (vec1 != vec2)
+        score -= 4;
+    else if (vec1 && vec2 && std::max(max1, max2) > 2 * std::min(min1, min2))
+        score -= 1;
+
+    outs() << "Fusion score: " << score << " (shared " << shared << ", streams " << streams
+           << ", vectorizable " << vec1 << "/" << vec2 << ")\n";
+    return score;
+}
+
+bool llvm::isFusionProfitable(Loop* l1, Loop* l2, ScalarEvolution &SE) {
+    if (IgnoreCostModel)
+        return true;
+    if (getFusionScore(l1, l2, SE) > 0)
+        return true;
+
+    errs() << "Loop fusion is not profitable\n";
+    return false;
+}
@@ -0,0 +1,17 @@
+#ifndef LLVM_TRANSFORMS_UTILS_FUSION_COST_MODEL_H
+#define LLVM_TRANSFORMS_UTILS_FUSION_COST_MODEL_H
+
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+
+namespace llvm {
+
+	// Punteggio della fusione di L1 e L2: positivo se conviene fondere.
+	// Parte da 0 e premia solo gli array condivisi (riuso in cache), penalizza troppi stream
+	// di memoria contemporanei e la perdita della vettorizzazione
+	int getFusionScore(Loop* l1, Loop* l2, ScalarEvolution &SE);
+
+	// Verifica se conviene fondere L1 e L2 (sempre con -loopfusion-ignore-cost-model)
+	bool isFusionProfitable(Loop* l1, Loop* l2, ScalarEvolution &SE);
+}
+#endif
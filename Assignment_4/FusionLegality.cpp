@@ -0,0 +1,225 @@
+#include "FusionLegality.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Analysis/MemoryLocation.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+// Load e store di un loop, raggruppati per oggetto sottostante
+typedef DenseMap<const Value*, SmallVector<Instruction*, 4>> MemoryAccessMap;
+
+// Raccoglie gli accessi in memoria del loop. Fallisce se il loop contiene
+// altre istruzioni che accedono alla memoria (es. chiamate)
+bool collectMemoryAccesses(Loop *L, MemoryAccessMap &accesses) {
+    for (auto *BB : L->blocks()) {
+        for (auto &I : *BB) {
+            if (isa<LoadInst>(I) || isa<StoreInst>(I)) {
+                const Value *object = getUnderlyingObject(getLoadStorePointerOperand(&I));
+                accesses[object].push_back(&I);
+                continue;
+            }
+            if (I.mayReadOrWriteMemory()) {
+                errs() << "Unsupported memory access: " << I << "\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Verifica che una distanza simbolica sia non negativa, usando anche le
+// condizioni che guardano il loop (es. n > 0 prima di entrare)
+bool isKnownNonNegativeDistance(const SCEV *dist, Loop *L, ScalarEvolution &SE) {
+    if (isa<SCEVCouldNotCompute>(dist))
+        return false;
+    return SE.isKnownNonNegative(SE.applyLoopGuards(dist, L));
+}
+
+// Ricorrenza dell'indirizzo S al livello del loop L. Gli accessi nei sottoloop
+// hanno la forma {{s,+,a}<L>,+,b}<Inner>: si scende lungo gli start e le
+// ricorrenze dei sottoloop attraversate vengono raccolte in inner
+const SCEVAddRecExpr *getRecurrenceAtLoop(const SCEV *S, Loop *L, SmallVectorImpl<const SCEVAddRecExpr*> &inner) {
+    while (auto *AR = dyn_cast<SCEVAddRecExpr>(S)) {
+        if (AR->getLoop() == L)
+            return AR;
+        if (!L->contains(AR->getLoop()) || !AR->isAffine())
+            return nullptr;
+        inner.push_back(AR);
+        S = AR->getStart();
+    }
+    return nullptr;
+}
+
+// Le dimensioni interne di due accessi (sottoloop di L1 e di L2) sono
+// identiche: stesso passo e stesso trip count a ogni livello
+bool haveIdenticalInnerDimensions(ArrayRef<const SCEVAddRecExpr*> inner1, ArrayRef<const SCEVAddRecExpr*> inner2,
+                                  ScalarEvolution &SE) {
+    if (inner1.size() != inner2.size())
+        return false;
+    for (unsigned i = 0; i < inner1.size(); ++i) {
+        const SCEV *tripCount = SE.getBackedgeTakenCount(inner1[i]->getLoop());
+        if (inner1[i]->getStepRecurrence(SE) != inner2[i]->getStepRecurrence(SE) ||
+            isa<SCEVCouldNotCompute>(tripCount) || tripCount != SE.getBackedgeTakenCount(inner2[i]->getLoop()))
+            return false;
+    }
+    return true;
+}
+
+// Byte toccati da I in un'iterazione del loop fuso: somma di |passo| * iterazioni
+// delle dimensioni interne, più la dimensione dell'accesso. Nei loop che escono
+// dall'header il corpo esegue una iterazione in meno del backedge-taken count
+const SCEV *getInnerExtent(Instruction *I, ArrayRef<const SCEVAddRecExpr*> inner, Type *offsetType,
+                           uint64_t accessSize, ScalarEvolution &SE) {
+    const SCEV *extent = SE.getConstant(offsetType, accessSize);
+    for (auto *AR : inner) {
+        const Loop *L = AR->getLoop();
+        const SCEV *tripCount = SE.getBackedgeTakenCount(L);
+        if (SE.getTypeSizeInBits(tripCount->getType()) > SE.getTypeSizeInBits(offsetType))
+            return SE.getCouldNotCompute();
+        tripCount = SE.getNoopOrZeroExtend(tripCount, offsetType);
+        if (L->getExitingBlock() == L->getHeader() && I->getParent() != L->getHeader())
+            tripCount = SE.getMinusSCEV(tripCount, SE.getOne(offsetType));
+        extent = SE.getAddExpr(extent, SE.getMulExpr(SE.getAbsExpr(AR->getStepRecurrence(SE), false), tripCount));
+    }
+    return extent;
+}
+
+// Distanza nella dimensione fusa: L1 accede a {s,+,step}<L1>, L2 a {d,+,step}<L2>,
+// eventualmente come start delle ricorrenze dei sottoloop (fusione di nidi).
+// Dopo la fusione l'iterazione k di L2 deve toccare indirizzi già scritti
+// (o letti) da L1 in iterazioni <= k, quindi (s-d)/step >= 0, a parità di
+// dimensioni interne. Inoltre le righe toccate in iterazioni diverse non
+// devono sovrapporsi: distanza + |passo| >= estensione della riga
+bool isFusedDistanceNonNegative(Instruction *I1, Instruction *I2, Loop *l1, Loop *l2, ScalarEvolution &SE) {
+    SmallVector<const SCEVAddRecExpr*, 2> inner1, inner2;
+    const SCEVAddRecExpr *AR1 = getRecurrenceAtLoop(SE.getSCEV(getLoadStorePointerOperand(I1)), l1, inner1);
+    const SCEVAddRecExpr *AR2 = getRecurrenceAtLoop(SE.getSCEV(getLoadStorePointerOperand(I2)), l2, inner2);
+    if (!AR1 || !AR2 || !AR1->isAffine() || !AR2->isAffine() || !haveIdenticalInnerDimensions(inner1, inner2, SE))
+        return false;
+
+    const SCEV *step = AR1->getStepRecurrence(SE);
+    if (step != AR2->getStepRecurrence(SE))
+        return false;
+
+    const SCEV *dist;
+    if (SE.isKnownPositive(step))
+        dist = SE.getMinusSCEV(AR1->getStart(), AR2->getStart());
+    else if (SE.isKnownNegative(step))
+        dist = SE.getMinusSCEV(AR2->getStart(), AR1->getStart());
+    else
+        return false;
+    if (!isKnownNonNegativeDistance(dist, l1, SE))
+        return false;
+
+    const DataLayout &DL = I1->getModule()->getDataLayout();
+    uint64_t accessSize = std::max(DL.getTypeStoreSize(getLoadStoreType(I1)).getFixedValue(),
+                                   DL.getTypeStoreSize(getLoadStoreType(I2)).getFixedValue());
+    auto rowsDoNotOverlap = [&](Instruction *I, ArrayRef<const SCEVAddRecExpr*> inner) {
+        const SCEV *extent = getInnerExtent(I, inner, step->getType(), accessSize, SE);
+        if (isa<SCEVCouldNotCompute>(extent))
+            return false;
+        const SCEV *gap = SE.getMinusSCEV(SE.getAddExpr(dist, SE.getAbsExpr(step, false)), extent);
+        return isKnownNonNegativeDistance(gap, l1, SE);
+    };
+    return rowsDoNotOverlap(I1, inner1) && rowsDoNotOverlap(I2, inner2);
+}
+
+// Verifica che la dipendenza fra due accessi non impedisca la fusione
+bool hasNegativeDistance(Instruction *I1, Instruction *I2, Loop *l1, Loop *l2, DependenceInfo &DI, ScalarEvolution &SE) {
+    auto Dep = DI.depends(I1, I2, true);
+    if (!Dep)
+        return false;
+
+    //Se esiste una dipendenza, controlla i livelli dei loop comuni
+    unsigned Levels = Dep->getLevels();
+    for (unsigned i = 1; i <= Levels; ++i) {
+        const SCEV *distSCEV = Dep->getDistance(i);
+        bool safe;
+        if (distSCEV) {
+            //Distanza costante o simbolica: il segno deve essere dimostrabile
+            safe = isKnownNonNegativeDistance(distSCEV, l1, SE);
+        }
+        else {
+            //Senza distanza si usa il vettore di direzione: niente '>'
+            safe = !(Dep->getDirection(i) & Dependence::DVEntry::GT);
+        }
+        if (!safe) {
+            errs() << "Possibly negative distance dependence found between:\n";
+            errs() << "  Instruction in L1: " << *I1 << "\n";
+            errs() << "  Instruction in L2: " << *I2 << "\n";
+            return true;
+        }
+    }
+
+    //L1 e L2 non sono loop comuni: la distanza nella dimensione fusa si
+    //ricava dagli indirizzi, anche per gli accessi nei sottoloop
+    if (!isFusedDistanceNonNegative(I1, I2, l1, l2, SE)) {
+        errs() << "Unknown fused distance between:\n";
+        errs() << "  Instruction in L1: " << *I1 << "\n";
+        errs() << "  Instruction in L2: " << *I2 << "\n";
+        return true;
+    }
+    return false;
+}
+
+// Verifica l'assenza di dipendenze di distanze negative
+bool llvm::areNotNegativeDistanceDependent(Loop* l1, Loop* l2, DependenceInfo &DI, ScalarEvolution &SE, AAResults &AA) {
+    MemoryAccessMap l1Accesses, l2Accesses;
+    if (!collectMemoryAccesses(l1, l1Accesses) || !collectMemoryAccesses(l2, l2Accesses))
+        return false;
+
+    for (auto &[object1, accesses1] : l1Accesses) {
+        for (auto &[object2, accesses2] : l2Accesses) {
+            //Oggetti diversi che non possono sovrapporsi: nessuna dipendenza
+            if (object1 != object2 &&
+                AA.isNoAlias(MemoryLocation::getBeforeOrAfter(object1), MemoryLocation::getBeforeOrAfter(object2)))
+                continue;
+
+            for (Instruction *I1 : accesses1) {
+                for (Instruction *I2 : accesses2) {
+                    //Due load non creano dipendenze
+                    if (!isa<StoreInst>(I1) && !isa<StoreInst>(I2))
+                        continue;
+                    if (AA.isNoAlias(MemoryLocation::get(I1), MemoryLocation::get(I2)))
+                        continue;
+                    if (hasNegativeDistance(I1, I2, l1, l2, DI, SE))
+                        return false;
+                }
+            }
+        }
+    }
+    outs() << "No negative distance dependence found\n";
+    return true;
+}
+
+bool llvm::mayConflictWithLoop(Instruction &I, Loop *L, AAResults &AA) {
+    if (!I.mayReadOrWriteMemory())
+        return false;
+
+    for (auto *BB : L->blocks()) {
+        for (auto &other : *BB) {
+            if (!other.mayReadOrWriteMemory())
+                continue;
+            //Due letture non sono in conflitto
+            if (!I.mayWriteToMemory() && !other.mayWriteToMemory())
+                continue;
+
+            ModRefInfo MR;
+            if (auto *call = dyn_cast<CallBase>(&I))
+                MR = AA.getModRefInfo(&other, call);
+            else if (isa<LoadInst>(I) || isa<StoreInst>(I))
+                MR = AA.getModRefInfo(&other, MemoryLocation::get(&I));
+            else
+                return true;
+
+            //Se I scrive basta un accesso, se legge serve una scrittura del loop
+            if (I.mayWriteToMemory() ? isModOrRefSet(MR) : isModSet(MR))
+                return true;
+        }
+    }
+    return false;
+}
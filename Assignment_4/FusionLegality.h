@@ -0,0 +1,21 @@
+#ifndef LLVM_TRANSFORMS_UTILS_FUSION_LEGALITY_H
+#define LLVM_TRANSFORMS_UTILS_FUSION_LEGALITY_H
+
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/DependenceAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+
+namespace llvm {
+
+	// Verifica che fra gli accessi in memoria di L1 e L2 non ci siano
+	// dipendenze a distanza negativa. DependenceInfo viene interrogata solo
+	// per le coppie load/store che possono fare alias
+	bool areNotNegativeDistanceDependent(Loop* l1, Loop* l2, DependenceInfo &DI, ScalarEvolution &SE, AAResults &AA);
+
+	// Verifica se l'istruzione (fuori dal loop) può accedere alla stessa
+	// memoria del loop con almeno una scrittura: in tal caso non si può
+	// spostarla dall'altra parte del loop
+	bool mayConflictWithLoop(Instruction &I, Loop *L, AAResults &AA);
+}
+#endif
@@ -0,0 +1,413 @@
+#include "LoopDistribution.h"
+#include "LoopFusion.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/DependenceAnalysis.h"
+#include "llvm/Analysis/LoopIterator.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/Local.h"
+
+#include <memory>
+
+using namespace llvm;
+
+static cl::opt<unsigned> DistributionMaxStreams(
+    "loopdistribution-max-streams", cl::init(16), cl::Hidden,
+    cl::desc("Max number of memory streams kept in a single distributed loop"));
+
+static cl::opt<bool> ForceDistribution(
+    "loopdistribution-force", cl::init(false), cl::Hidden,
+    cl::desc("Distribute every loop into one loop per dependence cycle, without merging partitions"));
+
+// Grafo delle dipendenze fra gli accessi in memoria del loop (in ordine di programma)
+struct DependenceGraph {
+    SmallVector<Instruction*, 16> nodes;
+    DenseMap<Instruction*, unsigned> index;
+    std::vector<SmallVector<unsigned, 4>> edges;
+    // Il nodo dipende da se stesso in un'altra iterazione (anche tramite una ricorrenza scalare)
+    std::vector<bool> carried;
+    // Coppie di nodi con una dipendenza in memoria fra iterazioni diverse
+    SmallVector<std::pair<unsigned, unsigned>, 8> carriedEdges;
+
+    void addEdge(unsigned from, unsigned to) {
+        if (!is_contained(edges[from], to))
+            edges[from].push_back(to);
+    }
+};
+
+// Accessi in memoria eseguiti nello stesso loop distribuito
+struct Partition {
+    SmallVector<Instruction*, 8> insts;
+    SmallPtrSet<const Value*, 8> objects;
+    bool cyclic = false;
+};
+
+// Load da cui dipende il valore V attraverso i calcoli del loop. recurrence
+// diventa true se si attraversa una PHI dell'header che non è una induction variable
+static void collectMemorySources(Value *V, Loop *L, ScalarEvolution &SE, SmallPtrSetImpl<Instruction*> &visited,
+                                 SmallVectorImpl<Instruction*> &sources, bool &recurrence) {
+    auto *I = dyn_cast<Instruction>(V);
+    if (!I || !L->contains(I) || !visited.insert(I).second)
+        return;
+
+    if (isa<LoadInst>(I)) {
+        sources.push_back(I);
+        return;
+    }
+
+    if (auto *PN = dyn_cast<PHINode>(I)) {
+        if (PN->getParent() == L->getHeader()) {
+            //Le induction variable vengono duplicate in ogni loop
+            auto *AR = SE.isSCEVable(PN->getType()) ? dyn_cast<SCEVAddRecExpr>(SE.getSCEV(PN)) : nullptr;
+            if (AR && AR->getLoop() == L)
+                return;
+            recurrence = true;
+        }
+    }
+
+    for (Value *Op : I->operands())
+        collectMemorySources(Op, L, SE, visited, sources, recurrence);
+}
+
+// Costruisce il grafo: archi di memoria dalle direzioni di DependenceInfo,
+// archi nei due sensi fra accessi legati da calcoli (devono restare insieme)
+static bool buildDependenceGraph(Loop *L, LoopInfo &LI, DependenceInfo &DI, ScalarEvolution &SE, DependenceGraph &G) {
+    LoopBlocksRPO RPO(L);
+    RPO.perform(&LI);
+
+    for (BasicBlock *BB : RPO) {
+        for (Instruction &I : *BB) {
+            if (isa<LoadInst>(I) || isa<StoreInst>(I)) {
+                if (isa<LoadInst>(I) ? !cast<LoadInst>(I).isSimple() : !cast<StoreInst>(I).isSimple())
+                    return false;
+                G.index[&I] = G.nodes.size();
+                G.nodes.push_back(&I);
+            }
+            else if (I.mayReadOrWriteMemory() || I.mayHaveSideEffects()) {
+                outs() << "Loop " << L->getHeader()->getName() << " is NOT worth distributing: " << I << "\n";
+                return false;
+            }
+
+            //Nessun valore usato dopo il loop
+            for (User *U : I.users()) {
+                if (!L->contains(cast<Instruction>(U)))
+                    return false;
+            }
+
+            //Il controllo del loop viene duplicato: non può dipendere dalla memoria
+            if (I.isTerminator()) {
+                SmallPtrSet<Instruction*, 16> visited;
+                SmallVector<Instruction*, 4> sources;
+                bool recurrence = false;
+                for (Value *Op : I.operands())
+                    collectMemorySources(Op, L, SE, visited, sources, recurrence);
+                if (!sources.empty()) {
+                    outs() << "Loop " << L->getHeader()->getName() << " is NOT worth distributing: control depends on memory\n";
+                    return false;
+                }
+            }
+        }
+    }
+
+    G.edges.resize(G.nodes.size());
+    G.carried.assign(G.nodes.size(), false);
+
+    //Dipendenze attraverso i registri
+    for (unsigned n = 0; n < G.nodes.size(); ++n) {
+        SmallPtrSet<Instruction*, 16> visited;
+        SmallVector<Instruction*, 4> sources;
+        bool recurrence = false;
+        for (Value *Op : G.nodes[n]->operands())
+            collectMemorySources(Op, L, SE, visited, sources, recurrence);
+
+        G.carried[n] = G.carried[n] || recurrence;
+        for (Instruction *source : sources) {
+            G.addEdge(G.index[source], n);
+            G.addEdge(n, G.index[source]);
+        }
+    }
+
+    //Dipendenze in memoria al livello del loop
+    unsigned level = L->getLoopDepth();
+    for (unsigned i = 0; i < G.nodes.size(); ++i) {
+        for (unsigned j = i; j < G.nodes.size(); ++j) {
+            if (!isa<StoreInst>(G.nodes[i]) && !isa<StoreInst>(G.nodes[j]))
+                continue;
+
+            auto Dep = DI.depends(G.nodes[i], G.nodes[j], true);
+            if (!Dep)
+                continue;
+
+            //Senza informazioni sulla direzione la dipendenza vale nei due sensi
+            unsigned direction = Dependence::DVEntry::ALL;
+            if (!Dep->isConfused() && Dep->getLevels() >= level)
+                direction = Dep->getDirection(level);
+
+            if (i == j) {
+                if (direction != Dependence::DVEntry::EQ)
+                    G.carried[i] = true;
+                continue;
+            }
+            if (direction & (Dependence::DVEntry::LT | Dependence::DVEntry::EQ))
+                G.addEdge(i, j);
+            if (direction & Dependence::DVEntry::GT)
+                G.addEdge(j, i);
+            if (direction & (Dependence::DVEntry::LT | Dependence::DVEntry::GT))
+                G.carriedEdges.push_back({i, j});
+        }
+    }
+    return true;
+}
+
+// Algoritmo di Tarjan: le SCC vengono prodotte in ordine topologico inverso
+static void findSCCs(DependenceGraph &G, unsigned v, unsigned &counter, std::vector<int> &order, std::vector<unsigned> &low,
+                     SmallVectorImpl<unsigned> &stack, std::vector<bool> &onStack, std::vector<SmallVector<unsigned, 4>> &sccs) {
+    order[v] = low[v] = counter++;
+    stack.push_back(v);
+    onStack[v] = true;
+
+    for (unsigned w : G.edges[v]) {
+        if (order[w] < 0) {
+            findSCCs(G, w, counter, order, low, stack, onStack, sccs);
+            low[v] = std::min(low[v], low[w]);
+        }
+        else if (onStack[w]) {
+            low[v] = std::min(low[v], (unsigned)order[w]);
+        }
+    }
+
+    if (low[v] != (unsigned)order[v])
+        return;
+
+    SmallVector<unsigned, 4> scc;
+    unsigned w;
+    do {
+        w = stack.pop_back_val();
+        onStack[w] = false;
+        scc.push_back(w);
+    } while (w != v);
+    sccs.push_back(scc);
+}
+
+// Partizioni contigue in ordine topologico: SCC consecutive dello stesso tipo
+// (cicliche o vettorizzabili) vengono unite finché gli stream restano nel limite,
+// tranne con -loopdistribution-force che lascia una partizione per SCC
+static std::vector<Partition> buildPartitions(DependenceGraph &G) {
+    unsigned n = G.nodes.size();
+    unsigned counter = 0;
+    std::vector<int> order(n, -1);
+    std::vector<unsigned> low(n, 0);
+    std::vector<bool> onStack(n, false);
+    SmallVector<unsigned, 16> stack;
+    std::vector<SmallVector<unsigned, 4>> sccs;
+    for (unsigned v = 0; v < n; ++v) {
+        if (order[v] < 0)
+            findSCCs(G, v, counter, order, low, stack, onStack, sccs);
+    }
+
+    //Gli archi fra load e store legati da calcoli vanno nei due sensi: una SCC
+    //è ciclica solo se contiene una dipendenza fra iterazioni diverse
+    std::vector<unsigned> component(n);
+    for (unsigned c = 0; c < sccs.size(); ++c) {
+        for (unsigned v : sccs[c])
+            component[v] = c;
+    }
+    std::vector<bool> cyclic(sccs.size(), false);
+    for (unsigned v = 0; v < n; ++v)
+        cyclic[component[v]] = cyclic[component[v]] || G.carried[v];
+    for (auto &[from, to] : G.carriedEdges) {
+        if (component[from] == component[to])
+            cyclic[component[from]] = true;
+    }
+
+    std::vector<Partition> partitions;
+    for (unsigned c = sccs.size(); c-- > 0;) {
+        auto &scc = sccs[c];
+        Partition part;
+        part.cyclic = cyclic[c];
+        for (unsigned v : scc) {
+            part.insts.push_back(G.nodes[v]);
+            part.objects.insert(getUnderlyingObject(getLoadStorePointerOperand(G.nodes[v])));
+        }
+
+        if (!ForceDistribution && !partitions.empty() && partitions.back().cyclic == part.cyclic) {
+            Partition &last = partitions.back();
+            SmallPtrSet<const Value*, 8> merged(last.objects.begin(), last.objects.end());
+            merged.insert(part.objects.begin(), part.objects.end());
+            if (merged.size() <= DistributionMaxStreams) {
+                last.insts.append(part.insts.begin(), part.insts.end());
+                last.objects = merged;
+                continue;
+            }
+        }
+        partitions.push_back(part);
+    }
+    return partitions;
+}
+
+// Conviene distribuire se si separa una ricorrenza dalla parte vettorizzabile
+// o se il loop accede a più stream di quelli gestiti dal prefetcher
+static bool isDistributionProfitable(std::vector<Partition> &partitions) {
+    if (partitions.size() < 2)
+        return false;
+    if (ForceDistribution)
+        return true;
+
+    bool hasCyclic = false, hasAcyclic = false;
+    SmallPtrSet<const Value*, 16> objects;
+    for (auto &part : partitions) {
+        hasCyclic |= part.cyclic;
+        hasAcyclic |= !part.cyclic;
+        objects.insert(part.objects.begin(), part.objects.end());
+    }
+    return (hasCyclic && hasAcyclic) || objects.size() > DistributionMaxStreams;
+}
+
+// Elimina dal loop gli accessi delle altre partizioni e i calcoli rimasti inutili
+static void pruneLoop(Loop *L, SmallVectorImpl<Instruction*> &victims) {
+    for (Instruction *I : victims) {
+        if (!I->getType()->isVoidTy())
+            I->replaceAllUsesWith(PoisonValue::get(I->getType()));
+        I->eraseFromParent();
+    }
+
+    for (BasicBlock *BB : L->blocks()) {
+        for (Instruction &I : make_early_inc_range(*BB)) {
+            if (isInstructionTriviallyDead(&I))
+                RecursivelyDeleteTriviallyDeadInstructions(&I);
+        }
+    }
+    for (PHINode &PN : make_early_inc_range(L->getHeader()->phis()))
+        RecursivelyDeleteDeadPHINode(&PN);
+}
+
+// I loop clonati ripetono il controllo di L (che non dipende dalla memoria):
+// sono adiacenti e con lo stesso trip count se L non ha guardia e il suo
+// trip count è calcolabile
+static bool canDistribute(Loop *L, ScalarEvolution &SE) {
+    return !L->isGuarded() && !isa<SCEVCouldNotCompute>(SE.getBackedgeTakenCount(L));
+}
+
+// Elimina i loop clonati, già scollegati dal CFG
+static void deleteClonedLoops(ArrayRef<Loop*> clones, SmallVectorImpl<BasicBlock*> &blocks, LoopInfo &LI, ScalarEvolution &SE) {
+    for (Loop *clone : clones)
+        SE.forgetLoop(clone);
+    for (BasicBlock *BB : blocks)
+        LI.removeBlock(BB);
+    for (Loop *clone : clones)
+        LI.erase(clone);
+    DeleteDeadBlocks(blocks);
+}
+
+// Crea un loop per ogni partizione tranne l'ultima, che resta nel loop
+// originale. I loop clonati precedono l'originale e sono adiacenti fra loro.
+// Restituisce false, senza distribuire, se i cloni non risultano adiacenti
+// e con lo stesso trip count
+static bool distributeLoop(Loop *L, std::vector<Partition> &partitions, LoopInfo &LI, DominatorTree &DT, ScalarEvolution &SE) {
+    SE.forgetLoop(L);
+
+    //Preheader vuoto con un solo predecessore: viene clonato per ogni loop
+    BasicBlock *preheader = L->getLoopPreheader();
+    if (preheader->size() > 1 || !preheader->getSinglePredecessor())
+        preheader = SplitBlock(preheader, preheader->getTerminator(), &DT, &LI);
+    BasicBlock *pred = preheader->getSinglePredecessor();
+    BasicBlock *exit = L->getExitBlock();
+
+    unsigned count = partitions.size();
+    std::vector<Loop*> loops(count, L);
+    std::vector<std::unique_ptr<ValueToValueMapTy>> maps(count);
+    BasicBlock *topPreheader = preheader;
+    SmallVector<BasicBlock*, 16> clonedBlocks;
+    for (int k = count - 2; k >= 0; --k) {
+        maps[k] = std::make_unique<ValueToValueMapTy>();
+        SmallVector<BasicBlock*, 8> blocks;
+        loops[k] = cloneLoopWithPreheader(topPreheader, pred, L, *maps[k], ".ldist" + Twine(k), &LI, &DT, blocks);
+        //Il clone esce nel preheader del loop successivo
+        (*maps[k])[exit] = topPreheader;
+        remapInstructionsInBlocks(blocks, *maps[k]);
+        topPreheader = loops[k]->getLoopPreheader();
+        clonedBlocks.append(blocks.begin(), blocks.end());
+    }
+    pred->getTerminator()->replaceUsesOfWith(preheader, topPreheader);
+    DT.recalculate(*preheader->getParent());
+
+    //Precondizioni della distribuzione, verificate prima di eliminare gli
+    //accessi: il controllo dei loop non dipende dalla memoria, quindi
+    //pruneLoop non può cambiarne il trip count
+    for (unsigned k = 0; k + 1 < count; ++k) {
+        if (areAdjacent(loops[k], loops[k + 1]) && sameTripCount(loops[k], loops[k + 1], SE))
+            continue;
+
+        errs() << "Distributed loops are not adjacent with the same trip count\n";
+        pred->getTerminator()->replaceUsesOfWith(topPreheader, preheader);
+        deleteClonedLoops(ArrayRef<Loop*>(loops).drop_back(), clonedBlocks, LI, SE);
+        DT.recalculate(*preheader->getParent());
+        return false;
+    }
+
+    //Ogni loop tiene solo gli accessi della sua partizione
+    for (unsigned k = 0; k < count; ++k) {
+        SmallVector<Instruction*, 8> victims;
+        for (unsigned j = 0; j < count; ++j) {
+            if (j == k)
+                continue;
+            for (Instruction *I : partitions[j].insts)
+                victims.push_back(maps[k] ? cast<Instruction>((*maps[k])[I]) : I);
+        }
+        pruneLoop(loops[k], victims);
+        outs() << "Partition " << k << (partitions[k].cyclic ? " (cyclic)" : "") << " --> loop "
+               << loops[k]->getHeader()->getName() << "\n";
+    }
+
+    for (Loop *distributed : loops)
+        SE.forgetLoop(distributed);
+    return true;
+}
+
+PreservedAnalyses LoopDistributionPass::run(Function &F, FunctionAnalysisManager &AM) {
+    LoopInfo &LI = AM.getResult<LoopAnalysis>(F);
+    DominatorTree &DT = AM.getResult<DominatorTreeAnalysis>(F);
+    ScalarEvolution &SE = AM.getResult<ScalarEvolutionAnalysis>(F);
+    DependenceInfo &DI = AM.getResult<DependenceAnalysis>(F);
+
+    bool Changed = false;
+
+    //Solo i loop più interni, con un solo exiting block
+    SmallVector<Loop*, 8> worklist;
+    for (Loop *L : LI.getLoopsInPreorder()) {
+        if (L->isInnermost())
+            worklist.push_back(L);
+    }
+
+    for (Loop *L : worklist) {
+        if (!L->isLoopSimplifyForm() || !L->getExitingBlock() || !L->getExitBlock()) {
+            outs() << "Loop " << L->getHeader()->getName() << " is NOT worth distributing: multiple exits\n";
+            continue;
+        }
+
+        DependenceGraph G;
+        if (!buildDependenceGraph(L, LI, DI, SE, G) || G.nodes.size() < 2)
+            continue;
+
+        std::vector<Partition> partitions = buildPartitions(G);
+        if (!canDistribute(L, SE) || !isDistributionProfitable(partitions)) {
+            outs() << "Loop " << L->getHeader()->getName() << " is NOT worth distributing\n";
+            continue;
+        }
+
+        outs() << "Distributing loop " << L->getHeader()->getName() << " into " << partitions.size() << " loops\n";
+        //Anche se la distribuzione si interrompe il preheader può essere stato diviso
+        Changed = true;
+        if (!distributeLoop(L, partitions, LI, DT, SE))
+            outs() << "Loop " << L->getHeader()->getName() << " was NOT distributed\n";
+    }
+
+    return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+}
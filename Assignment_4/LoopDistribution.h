@@ -0,0 +1,16 @@
+#ifndef LLVM_TRANSFORMS_UTILS_LOOP_DISTRIBUTION_PASS_H
+#define LLVM_TRANSFORMS_UTILS_LOOP_DISTRIBUTION_PASS_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+
+	// Distribuzione (fissione) dei loop interni: il grafo delle dipendenze
+	// fra gli accessi in memoria viene diviso in componenti fortemente connesse
+	// e ogni partizione conveniente viene eseguita in un loop separato
+	class LoopDistributionPass : public PassInfoMixin<LoopDistributionPass> {
+		public:
+		PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
+	};
+}
+#endif
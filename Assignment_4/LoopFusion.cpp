@@ -9,11 +9,31 @@ using namespace llvm;
 
 
 #include "LoopFusion.h"
+#include "FusionCleanup.h"
+#include "FusionCostModel.h"
+#include "LoopDistribution.h"
+#include "FusionLegality.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DepthFirstIterator.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Analysis/DomTreeUpdater.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/LoopSimplify.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
+#include "llvm/Analysis/AssumptionCache.h"
 
 
 using namespace llvm;
 
+static cl::opt<unsigned> MaxTripCountDifference(
+    "loopfusion-max-trip-count-difference", cl::init(8), cl::Hidden,
+    cl::desc("Max constant trip count difference handled by an epilogue loop"));
+
 BasicBlock* getLoopEntryBlock(Loop* l) {
     
     return (l->isGuarded()) ? l->getLoopPreheader()->getUniquePredecessor() : l->getLoopPreheader();
@@ -44,6 +64,29 @@ std::deque <Loop*> getLoops(LoopInfo &LI) {
     return loops;
 }
 
+// Sottoloop diretti di L, nell'ordine del programma
+std::deque <Loop*> getSubLoops(Loop *L) {
+    std::deque <Loop*> loops;
+
+    for (auto *SubLoop : L->getSubLoops()){
+        loops.push_back(SubLoop);
+    }
+
+    return loops;
+}
+
+// Rimuove da LoopInfo i blocchi che la fusione ha reso irraggiungibili
+void removeUnreachableBlocksFromLoopInfo(Function &F, LoopInfo &LI) {
+    df_iterator_default_set<BasicBlock*> reachable;
+    for (BasicBlock *BB : depth_first_ext(&F, reachable))
+        (void)BB;
+
+    for (BasicBlock &BB : F){
+        if (!reachable.count(&BB))
+            LI.removeBlock(&BB);
+    }
+}
+
 bool areAdjacent(Loop* l1, Loop* l2) {
 
     BasicBlock *l2EntryBlock = getLoopEntryBlock(l2);
@@ -84,6 +127,137 @@ bool areAdjacent(Loop* l1, Loop* l2) {
     return false;
 }
 
+// Blocchi fra l'uscita di L1 e il preheader di L2 (estremi inclusi): devono
+// formare una catena lineare senza PHI
+bool getInterveningBlocks(Loop* l1, Loop* l2, SmallVectorImpl<BasicBlock*> &chain) {
+    BasicBlock *BB = l1->getExitBlock();
+    BasicBlock *l2PreHeader = l2->getLoopPreheader();
+    if (!BB || !l2PreHeader)
+        return false;
+
+    while (true) {
+        if (!BB->phis().empty() || is_contained(chain, BB))
+            return false;
+        chain.push_back(BB);
+        if (BB == l2PreHeader)
+            return true;
+
+        BasicBlock *next = BB->getSingleSuccessor();
+        if (!next || next->getSinglePredecessor() != BB)
+            return false;
+        BB = next;
+    }
+}
+
+// Codice fra L1 e L2: blocchi intermedi, istruzioni e quelle che vanno sopra L1
+struct InterveningCode {
+    SmallVector<BasicBlock*, 4> chain;
+    SmallVector<Instruction*, 8> instructions;
+    SmallPtrSet<Instruction*, 8> hoisted;
+};
+
+// Decide, senza modificare l'IR, come rendere adiacenti L1 e L2: il codice
+// fra i due loop va nel preheader di L1 se non dipende da L1 ed è
+// speculabile, altrimenti dopo L2 se L2 non ne dipende e termina sempre
+bool canMakeAdjacent(Loop* l1, Loop* l2, DominatorTree &DT, ScalarEvolution &SE, AAResults &AA, InterveningCode &code) {
+    //Per i loop con guardia resta il controllo originale
+    if (l1->isGuarded() || l2->isGuarded())
+        return areAdjacent(l1, l2);
+
+    BasicBlock *l2Exit = l2->getExitBlock();
+    if (!l2Exit || !getInterveningBlocks(l1, l2, code.chain)) {
+        errs() << "Loops Not Adjacent\n";
+        return false;
+    }
+
+    SmallVectorImpl<Instruction*> &intervening = code.instructions;
+    for (auto *BB : code.chain) {
+        for (auto &I : *BB) {
+            if (!I.isTerminator())
+                intervening.push_back(&I);
+        }
+    }
+
+    //Sopra L1: operandi disponibili prima di L1, nessun conflitto in memoria
+    //con L1 né con le istruzioni che restano fra i due loop. L'istruzione
+    //viene eseguita anche se L1 non arriva alla sua uscita
+    SmallPtrSetImpl<Instruction*> &hoisted = code.hoisted;
+    SmallVector<Instruction*, 8> stayed;
+    for (Instruction *I : intervening) {
+        bool canHoist = isSafeToSpeculativelyExecute(I) && !mayConflictWithLoop(*I, l1, AA);
+        for (Value *Op : I->operands()) {
+            auto *OpInst = dyn_cast<Instruction>(Op);
+            if (OpInst && (l1->contains(OpInst) || (is_contained(intervening, OpInst) && !hoisted.count(OpInst))))
+                canHoist = false;
+        }
+        for (Instruction *other : stayed) {
+            if (I->mayReadOrWriteMemory() && other->mayReadOrWriteMemory() &&
+                (I->mayWriteToMemory() || other->mayWriteToMemory()))
+                canHoist = false;
+        }
+        if (canHoist)
+            hoisted.insert(I);
+        else
+            stayed.push_back(I);
+    }
+
+    //Sotto L2: L2 deve arrivare sempre alla sua uscita, altrimenti il codice
+    //spostato non verrebbe più eseguito
+    bool l2AlwaysExits = !isa<SCEVCouldNotCompute>(SE.getBackedgeTakenCount(l2)) &&
+                         all_of(l2->blocks(), [](BasicBlock *BB) { return isGuaranteedToTransferExecutionToSuccessor(BB); });
+    if (!stayed.empty() && !l2AlwaysExits) {
+        errs() << "Cannot move intervening code below L2: L2 may not exit\n";
+        return false;
+    }
+
+    //Gli usi sono spostati anch'essi o si trovano dopo L2
+    SmallPtrSet<Instruction*, 8> sunk;
+    for (Instruction *I : reverse(stayed)) {
+        if (!isGuaranteedToTransferExecutionToSuccessor(I) || mayConflictWithLoop(*I, l2, AA)) {
+            errs() << "Cannot move intervening instruction: " << *I << "\n";
+            return false;
+        }
+        for (Use &U : I->uses()) {
+            auto *user = cast<Instruction>(U.getUser());
+            BasicBlock *useBlock = user->getParent();
+            if (auto *PN = dyn_cast<PHINode>(user))
+                useBlock = PN->getIncomingBlock(U);
+            if (!sunk.count(user) && (l2->contains(user) || !DT.dominates(l2Exit, useBlock))) {
+                errs() << "Cannot move intervening instruction: " << *I << "\n";
+                return false;
+            }
+        }
+        sunk.insert(I);
+    }
+    return true;
+}
+
+// Rende L1 e L2 adiacenti secondo canMakeAdjacent. I blocchi rimasti
+// vuoti vengono uniti in un unico preheader di L2
+bool makeAdjacent(Loop* l1, Loop* l2, const InterveningCode &code, LoopInfo &LI, DomTreeUpdater &DTU, bool &moved) {
+    //Sposta il codice, mantenendo l'ordine originale
+    if (!code.instructions.empty()) {
+        Instruction *hoistPoint = l1->getLoopPreheader()->getTerminator();
+        Instruction *sinkPoint = &*l2->getExitBlock()->getFirstInsertionPt();
+        for (Instruction *I : code.instructions) {
+            outs() << (code.hoisted.count(I) ? "Hoisting above L1 --> " : "Sinking below L2 --> ") << *I << "\n";
+            I->moveBefore(code.hoisted.count(I) ? hoistPoint : sinkPoint);
+        }
+    }
+    moved = !code.instructions.empty() || code.chain.size() > 1;
+
+    //Unisce i blocchi vuoti: l'uscita di L1 diventa il preheader di L2
+    for (auto *BB : drop_begin(code.chain)) {
+        if (!MergeBlockIntoPredecessor(BB, &DTU, &LI)) {
+            errs() << "Cannot merge intervening block " << BB->getName() << "\n";
+            DTU.flush();
+            return false;
+        }
+    }
+    DTU.flush();
+    return true;
+}
+
 bool areCFEquivalent(Loop* l1, Loop* l2, DominatorTree &DT, PostDominatorTree &PDT) {
     BasicBlock* L1Block = getLoopEntryBlock(l1);
     BasicBlock* L2PreHeader = l2->getLoopPreheader();
@@ -102,25 +276,83 @@ bool sameTripCount(Loop* l1, Loop* l2, ScalarEvolution &SE) {
     const SCEV *l2TripCount = SE.getBackedgeTakenCount(l2);
 
     //Verifica che i due trip count siano uguali
-    if (l1TripCount == l2TripCount)
+    return l1TripCount == l2TripCount;
+}
+
+// Segno di BTC(L1) - BTC(L2): 1 se L1 è più lungo, -1 se lo è L2,
+// 0 se non si può stabilire o se la differenza costante supera il limite
+int getTripCountDifferenceSign(Loop* l1, Loop* l2, ScalarEvolution &SE) {
+    const SCEV *l1TripCount = SE.getBackedgeTakenCount(l1);
+    const SCEV *l2TripCount = SE.getBackedgeTakenCount(l2);
+    if (isa<SCEVCouldNotCompute>(l1TripCount) || isa<SCEVCouldNotCompute>(l2TripCount) ||
+        l1TripCount->getType() != l2TripCount->getType())
+        return 0;
+
+    const SCEV *diff = SE.applyLoopGuards(SE.getMinusSCEV(l1TripCount, l2TripCount), l1);
+    if (auto *C = dyn_cast<SCEVConstant>(diff)) {
+        if (C->getAPInt().abs().ugt(MaxTripCountDifference))
+            return 0;
+    }
+
+    if (SE.isKnownPositive(diff))
+        return 1;
+    if (SE.isKnownNegative(diff))
+        return -1;
+    return 0;
+}
+
+// I trip count sono uguali o differiscono di una quantità di segno noto:
+// le iterazioni in più vengono eseguite da un loop di epilogo
+bool compatibleTripCount(Loop* l1, Loop* l2, ScalarEvolution &SE) {
+    if (sameTripCount(l1, l2, SE) || getTripCountDifferenceSign(l1, l2, SE) != 0)
         return true;
 
-    errs() << "Loops do not have the same trip count\n";
+    errs() << "Loops do not have compatible trip counts\n";
     return false;
 }
 
-bool fuseLoop(Loop* l1, Loop* l2, LoopInfo &LI) {
-    // Recupera le induction variable canoniche
-    PHINode *l1IndVar = l1->getCanonicalInductionVariable();
-    PHINode *l2IndVar = l2->getCanonicalInductionVariable();
-    // Verifica che entrambe le induction variable siano valide
-    if (!l1IndVar || !l2IndVar) {
-        errs() << "One of the loops does not have a canonical induction variable.\n";
+// Le PHI dell'header di L2 devono essere induction variable affini {a2,+,s2}<L2>:
+// con trip count uguali la stessa ricorrenza su L1, {a2,+,s2}<L1>, ne dà il valore
+bool getL2IndVarsOnL1(Loop* l1, Loop* l2, ScalarEvolution &SE, SCEVExpander &Rewriter,
+                      SmallVectorImpl<std::pair<PHINode*, const SCEV*>> &l2IndVars) {
+    BasicBlock *l1Header = l1->getHeader();
+    Instruction *insertPoint = &*l1Header->getFirstInsertionPt();
+    for (PHINode &PN : l2->getHeader()->phis()) {
+        auto *AR = SE.isSCEVable(PN.getType()) ? dyn_cast<SCEVAddRecExpr>(SE.getSCEV(&PN)) : nullptr;
+        if (!AR || AR->getLoop() != l2 || !AR->isAffine()) {
+            errs() << "L2 header PHI is not an affine induction variable: " << PN << "\n";
+            return false;
+        }
+
+        const SCEV *start = AR->getStart();
+        const SCEV *step = AR->getStepRecurrence(SE);
+        const SCEV *l1IndVar = SE.getAddRecExpr(start, step, l1, SCEV::FlagAnyWrap);
+        if (!SE.properlyDominates(start, l1Header) || !SE.properlyDominates(step, l1Header) ||
+            !Rewriter.isSafeToExpandAt(l1IndVar, insertPoint)) {
+            errs() << "Cannot rewrite L2 induction variable in L1: " << PN << "\n";
+            return false;
+        }
+        l2IndVars.push_back({&PN, l1IndVar});
+    }
+    return true;
+}
+
+// Verifica, senza modificare l'IR, che fuseLoop possa fondere L1 e L2
+bool canFuseLoop(Loop* l1, Loop* l2, ScalarEvolution &SE) {
+    if (!l1->getHeader() || !l1->getLoopLatch() || !l2->getHeader() || !l2->getLoopLatch() ||
+        !l2->getExitBlock() || !getLoopEntryBlock(l2) || !getLoopBody(l2)) {
+        errs() << "Some basic blocks required for fusion are missing.\n";
         return false;
     }
 
-    // Sostituisci tutti gli usi della induction variable del secondo loop con quella del primo
-    l2IndVar->replaceAllUsesWith(l1IndVar);
+    SCEVExpander Rewriter(SE, l1->getHeader()->getModule()->getDataLayout(), "fusion.iv");
+    SmallVector<std::pair<PHINode*, const SCEV*>, 4> l2IndVars;
+    return getL2IndVarsOnL1(l1, l2, SE, Rewriter, l2IndVars);
+}
+
+bool fuseLoop(Loop* l1, Loop* l2, LoopInfo &LI, DomTreeUpdater &DTU, ScalarEvolution &SE) {
+    if (!canFuseLoop(l1, l2, SE))
+        return false;
 
     // Blocchi chiave
     BasicBlock *l1Header = l1->getHeader();
@@ -131,30 +363,50 @@ bool fuseLoop(Loop* l1, Loop* l2, LoopInfo &LI) {
     BasicBlock *l2PreHeader = getLoopEntryBlock(l2);
     BasicBlock *l2Body = getLoopBody(l2);
 
-    if (!l1Header || !l1Latch || !l2Header || !l2Latch || !l2Exit || !l2PreHeader || !l2Body) {
-        errs() << "Some basic blocks required for fusion are missing.\n";
-        return false;
+    Instruction *insertPoint = &*l1Header->getFirstInsertionPt();
+    SCEVExpander Rewriter(SE, l1Header->getModule()->getDataLayout(), "fusion.iv");
+    SmallVector<std::pair<PHINode*, const SCEV*>, 4> l2IndVars;
+    getL2IndVarsOnL1(l1, l2, SE, Rewriter, l2IndVars);
+
+    // Sostituisci tutti gli usi delle induction variable del secondo loop con
+    // la loro espressione in funzione del primo
+    for (auto &[PN, l1IndVar] : l2IndVars) {
+        Value *V = Rewriter.expandCodeFor(l1IndVar, PN->getType(), insertPoint);
+        PN->replaceAllUsesWith(V);
     }
 
+    // Archi modificati, per aggiornare DominatorTree e PostDominatorTree
+    SmallVector<DominatorTree::UpdateType, 16> updates;
+    auto redirect = [&](BasicBlock *from, BasicBlock *oldSucc, BasicBlock *newSucc) {
+        from->getTerminator()->replaceSuccessorWith(oldSucc, newSucc);
+        updates.push_back({DominatorTree::Delete, from, oldSucc});
+        updates.push_back({DominatorTree::Insert, from, newSucc});
+    };
+
     // Collega il latch del primo loop al corpo del secondo loop
-    for (auto *pred : predecessors(l1Latch)) {
+    SmallVector<BasicBlock*, 4> l1LatchPreds(predecessors(l1Latch));
+    for (auto *pred : l1LatchPreds) {
         if (pred != l1Header) // evita di modificare il backedge principale
-            pred->getTerminator()->replaceSuccessorWith(l1Latch, l2Body);
+            redirect(pred, l1Latch, l2Body);
     }
 
     // Collega il latch del secondo loop al latch del primo loop (chiusura ciclo fuso)
-    for (auto *pred : predecessors(l2Latch)) {
+    SmallVector<BasicBlock*, 4> l2LatchPreds(predecessors(l2Latch));
+    for (auto *pred : l2LatchPreds) {
         if (pred != l2Header)
-            pred->getTerminator()->replaceSuccessorWith(l2Latch, l1Latch);
+            redirect(pred, l2Latch, l1Latch);
     }
 
     // Collega l'header del primo loop direttamente all'exit del secondo
-    l1Header->getTerminator()->replaceSuccessorWith(l2PreHeader, l2Exit);
+    redirect(l1Header, l2PreHeader, l2Exit);
 
     // Collega l'header del secondo loop al suo corpo
-    l2Header->getTerminator()->replaceSuccessorWith(l2Body, l2Latch);
+    redirect(l2Header, l2Body, l2Latch);
+
+    DTU.applyUpdatesPermissive(updates);
 
-    // Sposta i blocchi del secondo loop (tranne header e latch) nel primo loop
+    // Sposta i blocchi del secondo loop (tranne header e latch) nel primo loop.
+    // I loop che contengono L1 e L2 hanno già questi blocchi
     std::vector<BasicBlock*> blocksToTransfer;
     for (auto *block : l2->blocks()) {
         if (block != l2Header && block != l2Latch) {
@@ -163,50 +415,178 @@ bool fuseLoop(Loop* l1, Loop* l2, LoopInfo &LI) {
     }
     for (auto *block : blocksToTransfer) {
         l2->removeBlockFromLoop(block);
-        l1->addBasicBlockToLoop(block, LI);
+        l1->addBlockEntry(block);
+        if (LI.getLoopFor(block) == l2)
+            LI.changeLoopFor(block, l1);
     }
 
+    // I sottoloop del secondo loop diventano sottoloop del primo (fusione di nidi)
+    while (!l2->isInnermost()) {
+        Loop *childLoop = *l2->begin();
+        l2->removeChildLoop(l2->begin());
+        l1->addChildLoop(childLoop);
+    }
+
+
+    // Il corpo di L1 è cambiato: ScalarEvolution deve ricalcolare i due loop
+    SE.forgetLoop(l1);
+    SE.forgetLoop(l2);
     return true;
 }
 
-// Verifica l'assenza di dipendenze di distanze negative
-bool areNotNegativeDistanceDependent(Loop* l1, Loop* l2, DependenceInfo &DI, ScalarEvolution &SE) {
-    for (auto *BBLoop1 : l1->blocks()) {
-        for (auto &InstLoop1 : *BBLoop1) {
-            for (auto *BBLoop2 : l2->blocks()) {
-                for (auto &InstLoop2 : *BBLoop2) {
-                    //Per ogni istruzione in L1 e L2, verifica se esiste una dipendenza
-                    if (auto Dep = DI.depends(&InstLoop1, &InstLoop2, true)) {
-                        if (Dep) {
-                            //Se esiste una dipendenza, controlla i livelli e le distanze
-                            unsigned Levels = Dep->getLevels();
-                            for (unsigned i = 1; i <= Levels; ++i) {
-                                const SCEV *distSCEV = Dep->getDistance(i);
-                                if (distSCEV) {
-                                    
-                                    if (const SCEVConstant *C = dyn_cast<SCEVConstant>(distSCEV)) {
-                                        int64_t dist = C->getAPInt().getSExtValue();
-                                        if (dist < 0) {
-                                            errs() << "Negative distance dependence found between:\n";
-                                            errs() << "  Instruction in L1: " << InstLoop1 << "\n";
-                                            errs() << "  Instruction in L2: " << InstLoop2 << "\n";
-                                            return false;
-                                        }
-                                    }
-                                    // Se non è costante, non possiamo garantire l'assenza di dipendenza negativa
-                                    //Puo essere un espressione simbolica
-                                }
-                            }
-                        }
-                    }
+// Unica PHI nell'header di L, se è una induction variable affine {a,+,s}<L>
+PHINode* getAffineIndVar(Loop* L, ScalarEvolution &SE) {
+    if (!hasSingleElement(L->getHeader()->phis()))
+        return nullptr;
+    PHINode *PN = &*L->getHeader()->phis().begin();
+    auto *AR = SE.isSCEVable(PN->getType()) ? dyn_cast<SCEVAddRecExpr>(SE.getSCEV(PN)) : nullptr;
+    return AR && AR->getLoop() == L && AR->isAffine() ? PN : nullptr;
+}
+
+// Verifica, senza modificare l'IR, che fuseLoopWithEpilogue possa fondere L1 e L2
+bool canFuseLoopWithEpilogue(Loop* l1, Loop* l2, DominatorTree &DT, ScalarEvolution &SE) {
+    int sign = getTripCountDifferenceSign(l1, l2, SE);
+    if (sign == 0)
+        return false;
+    Loop *longLoop = sign > 0 ? l1 : l2;
+
+    // Una sola induction variable affine in L2 e nel loop più lungo
+    PHINode *l2IndVar = getAffineIndVar(l2, SE);
+    BasicBlock *l1Header = l1->getHeader();
+    BasicBlock *l2Exit = l2->getExitBlock();
+    if (!l2IndVar || !getAffineIndVar(longLoop, SE) || !l1->getExitBlock() || !l2Exit ||
+        !l1->getLoopLatch() || !l2->getLoopLatch() || !getLoopBody(l1) || !getLoopBody(l2) ||
+        l1->isGuarded() || l2->isGuarded()) {
+        errs() << "Unsupported loops for epilogue fusion\n";
+        return false;
+    }
+
+    // Il loop più lungo viene clonato: preheader vuoto e nessun valore usato dopo il loop
+    if (longLoop->getLoopPreheader()->size() != 1 || !l2Exit->phis().empty()) {
+        errs() << "Unsupported longer loop for epilogue fusion\n";
+        return false;
+    }
+    for (auto *BB : longLoop->blocks()) {
+        for (auto &I : *BB) {
+            for (User *U : I.users()) {
+                if (!longLoop->contains(cast<Instruction>(U))) {
+                    errs() << "Longer loop value used after the loop: " << I << "\n";
+                    return false;
                 }
             }
         }
     }
-    outs() << "No negative distance dependence found\n";
+
+    // Se L1 è più lungo il loop fuso esce con il test di L2, che deve
+    // dipendere solo dalla induction variable e da valori disponibili prima di L1
+    BranchInst *l1Branch = dyn_cast<BranchInst>(l1Header->getTerminator());
+    BranchInst *l2Branch = dyn_cast<BranchInst>(l2->getHeader()->getTerminator());
+    ICmpInst *l2Cond = l2Branch && l2Branch->isConditional() ? dyn_cast<ICmpInst>(l2Branch->getCondition()) : nullptr;
+    if (longLoop == l1) {
+        if (!l1Branch || !l2Cond || l1->contains(l1Branch->getSuccessor(0)) != l2->contains(l2Branch->getSuccessor(0)))
+            return false;
+        for (Value *Op : l2Cond->operands()) {
+            auto *OpInst = dyn_cast<Instruction>(Op);
+            if (OpInst && OpInst != l2IndVar && !DT.dominates(OpInst, l1Header))
+                return false;
+        }
+    }
+    return canFuseLoop(l1, l2, SE);
+}
+
+// Fonde due loop con trip count diversi: il loop fuso esegue le iterazioni
+// comuni, il loop più lungo viene clonato in un epilogo che riparte dal
+// valore della sua induction variable all'uscita del loop fuso ed esegue le
+// iterazioni restanti
+bool fuseLoopWithEpilogue(Loop* l1, Loop* l2, LoopInfo &LI, DominatorTree &DT, DomTreeUpdater &DTU, ScalarEvolution &SE) {
+    if (!canFuseLoopWithEpilogue(l1, l2, DT, SE))
+        return false;
+
+    Loop *longLoop = getTripCountDifferenceSign(l1, l2, SE) > 0 ? l1 : l2;
+    PHINode *longIndVar = getAffineIndVar(longLoop, SE);
+    BasicBlock *l1Header = l1->getHeader();
+    BasicBlock *l1Exit = l1->getExitBlock();
+    BasicBlock *l2Exit = l2->getExitBlock();
+    BranchInst *l1Branch = cast<BranchInst>(l1Header->getTerminator());
+    BranchInst *l2Branch = cast<BranchInst>(l2->getHeader()->getTerminator());
+
+    // Epilogo: copia del loop più lungo fra l'uscita del loop fuso e l'exit di L2
+    DTU.flush();
+    ValueToValueMapTy VMap;
+    SmallVector<BasicBlock*, 8> epilogueBlocks;
+    Loop *epilogue = cloneLoopWithPreheader(l2Exit, l1Header, longLoop, VMap, ".epilogue", &LI, &DT, epilogueBlocks);
+    remapInstructionsInBlocks(epilogueBlocks, VMap);
+    BasicBlock *epiloguePreheader = epilogue->getLoopPreheader();
+
+    // L'epilogo parte dal valore della induction variable del loop più lungo
+    // all'uscita del loop fuso. Per L2 fuseLoop sostituisce la PHI con la
+    // stessa ricorrenza calcolata su L1, anche in questo uso
+    cast<PHINode>(VMap[longIndVar])->setIncomingValueForBlock(epiloguePreheader, longIndVar);
+
+    // L'epilogo di L1 prosegue verso l'exit di L2. Il test di uscita di L2
+    // usa la sua induction variable, riscritta anch'essa da fuseLoop
+    if (longLoop == l1) {
+        SmallVector<BasicBlock*, 4> exitingBlocks;
+        epilogue->getExitingBlocks(exitingBlocks);
+        for (auto *BB : exitingBlocks)
+            BB->getTerminator()->replaceSuccessorWith(l1Exit, l2Exit);
+
+        Instruction *fusedCond = cast<ICmpInst>(l2Branch->getCondition())->clone();
+        fusedCond->insertBefore(l1Branch);
+        l1Branch->setCondition(fusedCond);
+    }
+
+    if (!fuseLoop(l1, l2, LI, DTU, SE))
+        return false;
+
+    // Il loop fuso esce nell'epilogo, che parte dall'iterazione successiva all'ultima comune
+    l1Header->getTerminator()->replaceSuccessorWith(l2Exit, epiloguePreheader);
+
+    // Archi dell'epilogo, ora raggiungibile: cloneLoopWithPreheader ha già
+    // aggiunto i blocchi al DominatorTree, il PostDominatorTree li riceve qui
+    SmallVector<DominatorTree::UpdateType, 16> updates;
+    updates.push_back({DominatorTree::Delete, l1Header, l2Exit});
+    updates.push_back({DominatorTree::Insert, l1Header, epiloguePreheader});
+    for (auto *BB : epilogueBlocks) {
+        for (auto *succ : successors(BB))
+            updates.push_back({DominatorTree::Insert, BB, succ});
+    }
+    DTU.applyUpdatesPermissive(updates);
+
+    outs() << "Extra iterations moved to epilogue loop " << epilogue->getHeader()->getName() << "\n";
     return true;
 }
 
+// Rimuove dalla cache i verdetti di legalità che coinvolgono il loop L
+void invalidateLegality(DenseMap<std::pair<Loop*, Loop*>, bool> &cache, Loop *L) {
+    SmallVector<std::pair<Loop*, Loop*>, 4> stale;
+    for (auto &entry : cache) {
+        if (entry.first.first == L || entry.first.second == L)
+            stale.push_back(entry.first);
+    }
+    for (auto &key : stale)
+        cache.erase(key);
+}
+
+// Porta tutti i loop della funzione in forma normale (preheader dedicato,
+// exit block dedicati, un solo latch) aggiornando LoopInfo, DominatorTree e SCEV.
+// I loop restano top-tested: fuseLoop lavora sul branch dell'header
+bool canonicalizeLoops(Function &F, LoopInfo &LI, DominatorTree &DT, PostDominatorTree &PDT, ScalarEvolution &SE, AssumptionCache &AC) {
+    bool Changed = false;
+
+    for (Loop *L : LI.getLoopsInPreorder()) {
+        if (L->isLoopSimplifyForm())
+            continue;
+        outs() << "Canonicalizing loop " << L->getHeader()->getName() << "\n";
+        //simplifyLoop normalizza anche i sottoloop
+        Changed |= simplifyLoop(L, &DT, &LI, &SE, &AC, nullptr, false);
+    }
+
+    if (Changed)
+        PDT.recalculate(F);
+    return Changed;
+}
+
 PreservedAnalyses LoopFusionPass::run(Function &F, FunctionAnalysisManager &AM) {
 
     std::deque <Loop*> loops;
@@ -217,28 +597,57 @@ PreservedAnalyses LoopFusionPass::run(Function &F, FunctionAnalysisManager &AM)
 
     ScalarEvolution &SE = AM.getResult<ScalarEvolutionAnalysis>(F);
     DependenceInfo &DI = AM.getResult<DependenceAnalysis>(F);
+    AAResults &AA = AM.getResult<AAManager>(F);
+    AssumptionCache &AC = AM.getResult<AssumptionAnalysis>(F);
+
+    // Normalizza i loop che non sono già in forma normale
+    bool Changed = canonicalizeLoops(F, LI, DT, PDT, SE, AC);
+
+    // Verdetti di legalità già calcolati, validi finché i due loop non cambiano
+    DenseMap<std::pair<Loop*, Loop*>, bool> legalityCache;
+
+    // DominatorTree e PostDominatorTree aggiornati in modo incrementale
+    DomTreeUpdater DTU(&DT, &PDT, DomTreeUpdater::UpdateStrategy::Lazy);
+
+    // Loop prodotti da una fusione, da ripulire alla fine
+    SmallSetVector<Loop*, 8> fusedLoops;
+
+    // Genitori dei gruppi di loop fratelli ancora da esaminare (nullptr per
+    // i loop top-level), dall'esterno verso l'interno. Ogni gruppo viene
+    // visitato una volta; una fusione rimette in coda solo i gruppi toccati
+    std::deque<Loop*> worklist = {nullptr};
+    for (Loop *L : LI.getLoopsInPreorder())
+        worklist.push_back(L);
+    SmallPtrSet<Loop*, 16> queued(worklist.begin(), worklist.end());
 
-    bool fusionOccurred;
+    auto enqueue = [&](Loop *parent) {
+        if (queued.insert(parent).second)
+            worklist.push_back(parent);
+    };
+
+    while (!worklist.empty()) {
+        Loop *parent = worklist.front();
+        worklist.pop_front();
+        queued.erase(parent);
 
-    do {
         outs() << "\n-----------------------\n";
-        fusionOccurred = false;
-        loops = getLoops(LI);
-        
+        loops = parent ? getSubLoops(parent) : getLoops(LI);
+
         // Controlla che ci siano almeno due loop da fondere
         if (loops.size() < 2){
-            outs() << "Insufficient number of loops\n";
-            return PreservedAnalyses::all();
+            if (!parent)
+                outs() << "Insufficient number of loops\n";
+            continue;
         }
 
-        for (int i=0; i<loops.size()-1; i++){
+        for (int i=0; i+1<loops.size(); ){
             Loop* L1 = loops[i];
             Loop* L2 = loops[i+1];
 
             // Verifica che i loop non siano nulli
             if (!L1 || !L2) {
                 errs() << "One of the loops is null.\n";
-                return PreservedAnalyses::all();
+                return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
             }
 
             outs() << "ITERATION NUMBER : " << i << "\n";
@@ -254,31 +663,98 @@ PreservedAnalyses LoopFusionPass::run(Function &F, FunctionAnalysisManager &AM)
                 outs() << "\n";
             }
 
-            if(areCFEquivalent(L1, L2, DT, PDT) && areAdjacent(L1, L2) && sameTripCount(L1, L2, SE) && areNotNegativeDistanceDependent(L1, L2, DI, SE)){
+            // In cache solo i controlli che non modificano l'IR
+            auto key = std::make_pair(L1, L2);
+            auto cached = legalityCache.find(key);
+            bool legal;
+            if (cached != legalityCache.end()) {
+                legal = cached->second;
+            }
+            else {
+                legal = areCFEquivalent(L1, L2, DT, PDT) && compatibleTripCount(L1, L2, SE) && areNotNegativeDistanceDependent(L1, L2, DI, SE, AA);
+                legalityCache[key] = legal;
+            }
+
+            // La convenienza non va in cache: il punteggio dipende dai corpi
+            // dei loop, che cambiano con le fusioni
+            if (legal)
+                legal = isFusionProfitable(L1, L2, SE);
+
+            // Trip count diversi: iterazioni in più in un loop di epilogo
+            bool withEpilogue = !sameTripCount(L1, L2, SE);
+
+            // Controlli che dipendono dal codice attorno ai loop, fuori dalla
+            // cache. Il codice fra i due loop viene spostato solo se la fusione
+            // è possibile e dopo tutti gli altri controlli
+            InterveningCode intervening;
+            if (legal)
+                legal = (withEpilogue ? canFuseLoopWithEpilogue(L1, L2, DT, SE) : canFuseLoop(L1, L2, SE)) &&
+                        canMakeAdjacent(L1, L2, DT, SE, AA, intervening);
+            if (legal) {
+                bool moved = false;
+                legal = makeAdjacent(L1, L2, intervening, LI, DTU, moved);
+                Changed |= moved;
+            }
+
+            if(legal){
                 outs() << "Loop " << i << " and " << i+1 << " are Loop Fusion Candidates\n";
-                
-                
-                if(fuseLoop(L1, L2, LI)){
+
+                SE.forgetLoop(L1);
+                SE.forgetLoop(L2);
+                bool fused = withEpilogue ? fuseLoopWithEpilogue(L1, L2, LI, DT, DTU, SE) : fuseLoop(L1, L2, LI, DTU, SE);
+                if(fused){
+                    // I verdetti che coinvolgono i loop modificati non valgono più
+                    invalidateLegality(legalityCache, L2);
+                    for (Loop *L = L1; L; L = L->getParentLoop())
+                        invalidateLegality(legalityCache, L);
+
+                    // I sottoloop di L2 ora sono fratelli di quelli di L1, e il
+                    // genitore è cambiato: i due gruppi vanno riesaminati
+                    if (!L1->isInnermost())
+                        enqueue(L1);
+                    if (parent)
+                        enqueue(parent->getParentLoop());
+
+                    removeUnreachableBlocksFromLoopInfo(F, LI);
+                    fusedLoops.remove(L2);
+                    fusedLoops.insert(L1);
+                    // L2 viene distrutto: se è in coda come genitore va tolto,
+                    // il suo indirizzo può essere riusato da un nuovo loop
+                    if (queued.erase(L2))
+                        worklist.erase(std::remove(worklist.begin(), worklist.end(), L2), worklist.end());
                     LI.erase(L2);
                     outs() << "Fused Loop " << i << " and " << i+1 << "\n"; 
-                    EliminateUnreachableBlocks(F);
+                    EliminateUnreachableBlocks(F, &DTU);
+                    DTU.flush();
 
-                    fusionOccurred = true;
-                    break;
+                    // L1 viene confrontato con il loop che seguiva L2
+                    loops.erase(loops.begin() + i + 1);
+                    Changed = true;
+                    continue;
                 }
                 else{
                     outs() << "Unable to fuse Loop " << i << " and " << i+1 << "\n"; 
+                    legalityCache[key] = false;
                 }              
             }
             else {
                 outs() << "Loop " << i << " and " << i+1 << " are NOT Loop Fusion Candidates\n";
-            }  
+            }
+            ++i;
+        }
+    }
+
+    // Store-to-load forwarding e load ridondanti nei corpi fusi
+    if (!fusedLoops.empty()) {
+        MemorySSA MSSA(F, &AA, &DT);
+        for (Loop *L : fusedLoops) {
+            SE.forgetLoop(L);
+            eliminateRedundantLoads(L, LI, DT, MSSA, AA);
         }
     }
-    while(fusionOccurred);
     
     
-    return PreservedAnalyses::all();
+    return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
 }
 
 extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo llvmGetPassPluginInfo() {
@@ -292,6 +768,10 @@ extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo llvmGetPassPluginIn
                         FPM.addPass(LoopFusionPass());
                         return true;
                     }
+                    if (Name == "LoopDistribution") {
+                        FPM.addPass(LoopDistributionPass());
+                        return true;
+                    }
                     return false;
                 });
         }
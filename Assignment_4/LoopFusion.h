@@ -17,4 +17,10 @@ namespace llvm {
 		PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
 	};
 }
+
+// Utility condivise con LoopDistribution (definite in LoopFusion.cpp)
+llvm::BasicBlock* getLoopEntryBlock(llvm::Loop* l);
+llvm::BasicBlock* getLoopBody(llvm::Loop *L);
+bool areAdjacent(llvm::Loop* l1, llvm::Loop* l2);
+bool sameTripCount(llvm::Loop* l1, llvm::Loop* l2, llvm::ScalarEvolution &SE);
 #endif
@@ -0,0 +1,17 @@
+// Input di LoopFusion con una catena di tre loop: dopo la prima fusione il loop
+// fuso viene confrontato subito con il successivo e i tre loop diventano uno;
+// i parametri restrict rendono legale la fusione
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopChain.ll -o test/LoopChain.opt.bc
+//
+void foo(int N, int *restrict a, int *restrict b, int *restrict c, int *restrict d) {
+
+	for (int i=0; i<N; i++)
+	       a[i] = b[i]*c[i];
+
+	for (int i=0; i<N; i++)
+		d[i] = a[i]+c[i];
+
+	for (int i=0; i<N; i++)
+		a[i] = c[i]-1;
+}
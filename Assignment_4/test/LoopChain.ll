@@ -0,0 +1,92 @@
+; ModuleID = 'test/LoopChain.c'
+source_filename = "test/LoopChain.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @foo(i32 noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, ptr noalias noundef %3, ptr noalias noundef %4) {
+  br label %6
+
+6:                                                ; preds = %19, %5
+  %7 = phi i32 [ 0, %5 ], [ %20, %19 ]
+  %8 = icmp slt i32 %7, %0
+  br i1 %8, label %9, label %21
+
+9:                                                ; preds = %6
+  %10 = sext i32 %7 to i64
+  %11 = getelementptr inbounds i32, ptr %2, i64 %10
+  %12 = load i32, ptr %11, align 4
+  %13 = sext i32 %7 to i64
+  %14 = getelementptr inbounds i32, ptr %3, i64 %13
+  %15 = load i32, ptr %14, align 4
+  %16 = mul nsw i32 %12, %15
+  %17 = sext i32 %7 to i64
+  %18 = getelementptr inbounds i32, ptr %1, i64 %17
+  store i32 %16, ptr %18, align 4
+  br label %19
+
+19:                                               ; preds = %9
+  %20 = add nsw i32 %7, 1
+  br label %6, !llvm.loop !4
+
+21:                                               ; preds = %6
+  br label %22
+
+22:                                               ; preds = %35, %21
+  %23 = phi i32 [ 0, %21 ], [ %36, %35 ]
+  %24 = icmp slt i32 %23, %0
+  br i1 %24, label %25, label %37
+
+25:                                               ; preds = %22
+  %26 = sext i32 %23 to i64
+  %27 = getelementptr inbounds i32, ptr %1, i64 %26
+  %28 = load i32, ptr %27, align 4
+  %29 = sext i32 %23 to i64
+  %30 = getelementptr inbounds i32, ptr %3, i64 %29
+  %31 = load i32, ptr %30, align 4
+  %32 = add nsw i32 %28, %31
+  %33 = sext i32 %23 to i64
+  %34 = getelementptr inbounds i32, ptr %4, i64 %33
+  store i32 %32, ptr %34, align 4
+  br label %35
+
+35:                                               ; preds = %25
+  %36 = add nsw i32 %23, 1
+  br label %22, !llvm.loop !6
+
+37:                                               ; preds = %22
+  br label %38
+
+38:                                               ; preds = %48, %37
+  %39 = phi i32 [ 0, %37 ], [ %49, %48 ]
+  %40 = icmp slt i32 %39, %0
+  br i1 %40, label %41, label %50
+
+41:                                               ; preds = %38
+  %42 = sext i32 %39 to i64
+  %43 = getelementptr inbounds i32, ptr %3, i64 %42
+  %44 = load i32, ptr %43, align 4
+  %45 = sub nsw i32 %44, 1
+  %46 = sext i32 %39 to i64
+  %47 = getelementptr inbounds i32, ptr %1, i64 %46
+  store i32 %45, ptr %47, align 4
+  br label %48
+
+48:                                               ; preds = %41
+  %49 = add nsw i32 %39, 1
+  br label %38, !llvm.loop !7
+
+50:                                               ; preds = %38
+  ret void
+}
+
+!llvm.module.flags = !{!0, !1, !2}
+!llvm.ident = !{!3}
+
+!0 = !{i32 1, !"wchar_size", i32 4}
+!1 = !{i32 7, !"uwtable", i32 2}
+!2 = !{i32 7, !"frame-pointer", i32 2}
+!3 = !{!"clang version 18.1.6 (Fedora 18.1.6-3.fc40)"}
+!4 = distinct !{!4, !5}
+!5 = !{!"llvm.loop.mustprogress"}
+!6 = distinct !{!6, !5}
+!7 = distinct !{!7, !5}
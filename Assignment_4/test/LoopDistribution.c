@@ -0,0 +1,20 @@
+// Input di LoopDistribution: in recurrence a[i] dipende da a[i - 1] (partizione
+// ciclica) mentre b[i] = c[i] * 2 è indipendente e vettorizzabile, quindi il loop
+// viene diviso in due; in streams le due copie sono entrambe acicliche e
+// dividerle non conviene
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopDistribution test/LoopDistribution.ll -o test/LoopDistribution.opt.bc
+//
+void recurrence(int *restrict a, int *restrict b, int *restrict c, int n) {
+	for (int i = 1; i < n; i++) {
+		a[i] = a[i - 1] + i;
+		b[i] = c[i] * 2;
+	}
+}
+
+void streams(int *restrict a, int *restrict b, int *restrict c, int *restrict d, int n) {
+	for (int i = 0; i < n; i++) {
+		b[i] = a[i];
+		d[i] = c[i];
+	}
+}
@@ -0,0 +1,64 @@
+; ModuleID = 'test/LoopDistribution.c'
+source_filename = "test/LoopDistribution.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @recurrence(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %20, %4
+  %6 = phi i32 [ 1, %4 ], [ %21, %20 ]
+  %7 = icmp slt i32 %6, %3
+  br i1 %7, label %8, label %22
+
+8:                                                ; preds = %5
+  %9 = sub nsw i32 %6, 1
+  %10 = sext i32 %9 to i64
+  %11 = getelementptr inbounds i32, ptr %0, i64 %10
+  %12 = load i32, ptr %11, align 4
+  %13 = add nsw i32 %12, %6
+  %14 = sext i32 %6 to i64
+  %15 = getelementptr inbounds i32, ptr %0, i64 %14
+  store i32 %13, ptr %15, align 4
+  %16 = getelementptr inbounds i32, ptr %2, i64 %14
+  %17 = load i32, ptr %16, align 4
+  %18 = mul nsw i32 %17, 2
+  %19 = getelementptr inbounds i32, ptr %1, i64 %14
+  store i32 %18, ptr %19, align 4
+  br label %20
+
+20:                                               ; preds = %8
+  %21 = add nsw i32 %6, 1
+  br label %5
+
+22:                                               ; preds = %5
+  ret void
+}
+
+define dso_local void @streams(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, ptr noalias noundef %3, i32 noundef %4) {
+  br label %6
+
+6:                                                ; preds = %17, %5
+  %7 = phi i32 [ 0, %5 ], [ %18, %17 ]
+  %8 = icmp slt i32 %7, %4
+  br i1 %8, label %9, label %19
+
+9:                                                ; preds = %6
+  %10 = sext i32 %7 to i64
+  %11 = getelementptr inbounds i32, ptr %0, i64 %10
+  %12 = load i32, ptr %11, align 4
+  %13 = getelementptr inbounds i32, ptr %1, i64 %10
+  store i32 %12, ptr %13, align 4
+  %14 = getelementptr inbounds i32, ptr %2, i64 %10
+  %15 = load i32, ptr %14, align 4
+  %16 = getelementptr inbounds i32, ptr %3, i64 %10
+  store i32 %15, ptr %16, align 4
+  br label %17
+
+17:                                               ; preds = %9
+  %18 = add nsw i32 %7, 1
+  br label %6
+
+19:                                               ; preds = %6
+  ret void
+}
@@ -0,0 +1,11 @@
+// Input di LoopDistribution con -loopdistribution-force: il loop viene diviso
+// anche se le partizioni sono tutte acicliche e gli stream sono pochi
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopDistribution -loopdistribution-force test/LoopDistributionForce.ll -o test/LoopDistributionForce.opt.bc
+//
+void streams(int *restrict a, int *restrict b, int *restrict c, int *restrict d, int n) {
+	for (int i = 0; i < n; i++) {
+		b[i] = a[i];
+		d[i] = c[i];
+	}
+}
@@ -0,0 +1,11 @@
+// Input di LoopDistribution con -loopdistribution-max-streams=3: il loop usa
+// quattro array, più di quelli consentiti, e viene diviso in due loop
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopDistribution -loopdistribution-max-streams=3 test/LoopDistributionStreams.ll -o test/LoopDistributionStreams.opt.bc
+//
+void streams(int *restrict a, int *restrict b, int *restrict c, int *restrict d, int n) {
+	for (int i = 0; i < n; i++) {
+		b[i] = a[i];
+		d[i] = c[i];
+	}
+}
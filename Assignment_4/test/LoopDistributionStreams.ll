@@ -0,0 +1,32 @@
+; ModuleID = 'test/LoopDistributionStreams.c'
+source_filename = "test/LoopDistributionStreams.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @streams(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, ptr noalias noundef %3, i32 noundef %4) {
+  br label %6
+
+6:                                                ; preds = %17, %5
+  %7 = phi i32 [ 0, %5 ], [ %18, %17 ]
+  %8 = icmp slt i32 %7, %4
+  br i1 %8, label %9, label %19
+
+9:                                                ; preds = %6
+  %10 = sext i32 %7 to i64
+  %11 = getelementptr inbounds i32, ptr %0, i64 %10
+  %12 = load i32, ptr %11, align 4
+  %13 = getelementptr inbounds i32, ptr %1, i64 %10
+  store i32 %12, ptr %13, align 4
+  %14 = getelementptr inbounds i32, ptr %2, i64 %10
+  %15 = load i32, ptr %14, align 4
+  %16 = getelementptr inbounds i32, ptr %3, i64 %10
+  store i32 %15, ptr %16, align 4
+  br label %17
+
+17:                                               ; preds = %9
+  %18 = add nsw i32 %7, 1
+  br label %6
+
+19:                                               ; preds = %6
+  ret void
+}
@@ -0,0 +1,22 @@
+// Input di LoopFusion con dipendenze fra accessi: b e c non possono sovrapporsi
+// ad a e vengono saltati; in same L2 legge a[i] scritto dalla stessa iterazione
+// di L1 e i loop vengono fusi, in ahead legge a[i + 1] che L1 non ha ancora
+// scritto e la fusione viene rifiutata
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopFusionAccesses.ll -o test/LoopFusionAccesses.opt.bc
+//
+void same(int *restrict a, int *restrict b, int *restrict c, long n) {
+	for (long i = 0; i < n; i++)
+		a[i] = b[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i] + b[i];
+}
+
+void ahead(int *restrict a, int *restrict b, int *restrict c, long n) {
+	for (long i = 0; i < n; i++)
+		a[i] = b[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i + 1] + b[i];
+}
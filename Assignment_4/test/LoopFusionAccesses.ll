@@ -0,0 +1,95 @@
+; ModuleID = 'test/LoopFusionAccesses.c'
+source_filename = "test/LoopFusionAccesses.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @same(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %12, %4
+  %6 = phi i64 [ 0, %4 ], [ %13, %12 ]
+  %7 = icmp slt i64 %6, %3
+  br i1 %7, label %8, label %14
+
+8:                                                ; preds = %5
+  %9 = getelementptr inbounds i32, ptr %1, i64 %6
+  %10 = load i32, ptr %9, align 4
+  %11 = getelementptr inbounds i32, ptr %0, i64 %6
+  store i32 %10, ptr %11, align 4
+  br label %12
+
+12:                                               ; preds = %8
+  %13 = add nsw i64 %6, 1
+  br label %5
+
+14:                                               ; preds = %5
+  br label %15
+
+15:                                               ; preds = %25, %14
+  %16 = phi i64 [ 0, %14 ], [ %26, %25 ]
+  %17 = icmp slt i64 %16, %3
+  br i1 %17, label %18, label %27
+
+18:                                               ; preds = %15
+  %19 = getelementptr inbounds i32, ptr %0, i64 %16
+  %20 = load i32, ptr %19, align 4
+  %21 = getelementptr inbounds i32, ptr %1, i64 %16
+  %22 = load i32, ptr %21, align 4
+  %23 = add nsw i32 %20, %22
+  %24 = getelementptr inbounds i32, ptr %2, i64 %16
+  store i32 %23, ptr %24, align 4
+  br label %25
+
+25:                                               ; preds = %18
+  %26 = add nsw i64 %16, 1
+  br label %15
+
+27:                                               ; preds = %15
+  ret void
+}
+
+define dso_local void @ahead(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %12, %4
+  %6 = phi i64 [ 0, %4 ], [ %13, %12 ]
+  %7 = icmp slt i64 %6, %3
+  br i1 %7, label %8, label %14
+
+8:                                                ; preds = %5
+  %9 = getelementptr inbounds i32, ptr %1, i64 %6
+  %10 = load i32, ptr %9, align 4
+  %11 = getelementptr inbounds i32, ptr %0, i64 %6
+  store i32 %10, ptr %11, align 4
+  br label %12
+
+12:                                               ; preds = %8
+  %13 = add nsw i64 %6, 1
+  br label %5
+
+14:                                               ; preds = %5
+  br label %15
+
+15:                                               ; preds = %26, %14
+  %16 = phi i64 [ 0, %14 ], [ %27, %26 ]
+  %17 = icmp slt i64 %16, %3
+  br i1 %17, label %18, label %28
+
+18:                                               ; preds = %15
+  %19 = add nsw i64 %16, 1
+  %20 = getelementptr inbounds i32, ptr %0, i64 %19
+  %21 = load i32, ptr %20, align 4
+  %22 = getelementptr inbounds i32, ptr %1, i64 %16
+  %23 = load i32, ptr %22, align 4
+  %24 = add nsw i32 %21, %23
+  %25 = getelementptr inbounds i32, ptr %2, i64 %16
+  store i32 %24, ptr %25, align 4
+  br label %26
+
+26:                                               ; preds = %18
+  %27 = add nsw i64 %16, 1
+  br label %15
+
+28:                                               ; preds = %15
+  ret void
+}
@@ -0,0 +1,13 @@
+// Input di LoopFusion con pulizia dopo la fusione: nel loop fuso il load di
+// a[i] legge il valore appena scritto e viene sostituito dallo store, il
+// secondo load di c[i] viene sostituito dal primo
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopFusionCleanup.ll -o test/LoopFusionCleanup.opt.bc
+//
+void cleanup(int *restrict a, int *restrict b, int *restrict c, int n) {
+	for (int i = 0; i < n; i++)
+		a[i] = c[i] + 1;
+
+	for (int i = 0; i < n; i++)
+		b[i] = a[i] * c[i];
+}
@@ -0,0 +1,49 @@
+; ModuleID = 'test/LoopFusionCleanup.c'
+source_filename = "test/LoopFusionCleanup.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @cleanup(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i32 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %14, %4
+  %6 = phi i32 [ 0, %4 ], [ %15, %14 ]
+  %7 = icmp slt i32 %6, %3
+  br i1 %7, label %8, label %16
+
+8:                                                ; preds = %5
+  %9 = sext i32 %6 to i64
+  %10 = getelementptr inbounds i32, ptr %2, i64 %9
+  %11 = load i32, ptr %10, align 4
+  %12 = add nsw i32 %11, 1
+  %13 = getelementptr inbounds i32, ptr %0, i64 %9
+  store i32 %12, ptr %13, align 4
+  br label %14
+
+14:                                               ; preds = %8
+  %15 = add nsw i32 %6, 1
+  br label %5
+
+16:                                               ; preds = %27, %5
+  %17 = phi i32 [ 0, %5 ], [ %28, %27 ]
+  %18 = icmp slt i32 %17, %3
+  br i1 %18, label %19, label %29
+
+19:                                               ; preds = %16
+  %20 = sext i32 %17 to i64
+  %21 = getelementptr inbounds i32, ptr %0, i64 %20
+  %22 = load i32, ptr %21, align 4
+  %23 = getelementptr inbounds i32, ptr %2, i64 %20
+  %24 = load i32, ptr %23, align 4
+  %25 = mul nsw i32 %22, %24
+  %26 = getelementptr inbounds i32, ptr %1, i64 %20
+  store i32 %25, ptr %26, align 4
+  br label %27
+
+27:                                               ; preds = %19
+  %28 = add nsw i32 %17, 1
+  br label %16
+
+29:                                               ; preds = %16
+  ret void
+}
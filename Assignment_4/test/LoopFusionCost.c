@@ -0,0 +1,29 @@
+// Input del cost model di LoopFusion con -loopfusion-max-streams=3: in shared
+// i loop leggono entrambi a e vengono fusi; in disjoint non condividono dati e
+// i quattro stream superano il limite; in strided solo L1 è vettorizzabile
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion -loopfusion-max-streams=3 test/LoopFusionCost.ll -o test/LoopFusionCost.opt.bc
+//
+void shared(int *restrict a, int *restrict b, int *restrict c, long n) {
+	for (long i = 0; i < n; i++)
+		b[i] = a[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i];
+}
+
+void disjoint(int *restrict a, int *restrict b, int *restrict c, int *restrict d, long n) {
+	for (long i = 0; i < n; i++)
+		b[i] = a[i];
+
+	for (long i = 0; i < n; i++)
+		d[i] = c[i];
+}
+
+void strided(int *restrict a, int *restrict b, int *restrict c, long n) {
+	for (long i = 0; i < n; i++)
+		b[i] = a[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i * 2];
+}
@@ -0,0 +1,131 @@
+; ModuleID = 'test/LoopFusionCost.c'
+source_filename = "test/LoopFusionCost.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @shared(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %12, %4
+  %6 = phi i64 [ 0, %4 ], [ %13, %12 ]
+  %7 = icmp slt i64 %6, %3
+  br i1 %7, label %8, label %14
+
+8:                                                ; preds = %5
+  %9 = getelementptr inbounds i32, ptr %0, i64 %6
+  %10 = load i32, ptr %9, align 4
+  %11 = getelementptr inbounds i32, ptr %1, i64 %6
+  store i32 %10, ptr %11, align 4
+  br label %12
+
+12:                                               ; preds = %8
+  %13 = add nsw i64 %6, 1
+  br label %5
+
+14:                                               ; preds = %5
+  br label %15
+
+15:                                               ; preds = %22, %14
+  %16 = phi i64 [ 0, %14 ], [ %23, %22 ]
+  %17 = icmp slt i64 %16, %3
+  br i1 %17, label %18, label %24
+
+18:                                               ; preds = %15
+  %19 = getelementptr inbounds i32, ptr %0, i64 %16
+  %20 = load i32, ptr %19, align 4
+  %21 = getelementptr inbounds i32, ptr %2, i64 %16
+  store i32 %20, ptr %21, align 4
+  br label %22
+
+22:                                               ; preds = %18
+  %23 = add nsw i64 %16, 1
+  br label %15
+
+24:                                               ; preds = %15
+  ret void
+}
+
+define dso_local void @disjoint(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, ptr noalias noundef %3, i64 noundef %4) {
+  br label %6
+
+6:                                                ; preds = %13, %5
+  %7 = phi i64 [ 0, %5 ], [ %14, %13 ]
+  %8 = icmp slt i64 %7, %4
+  br i1 %8, label %9, label %15
+
+9:                                                ; preds = %6
+  %10 = getelementptr inbounds i32, ptr %0, i64 %7
+  %11 = load i32, ptr %10, align 4
+  %12 = getelementptr inbounds i32, ptr %1, i64 %7
+  store i32 %11, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %9
+  %14 = add nsw i64 %7, 1
+  br label %6
+
+15:                                               ; preds = %6
+  br label %16
+
+16:                                               ; preds = %23, %15
+  %17 = phi i64 [ 0, %15 ], [ %24, %23 ]
+  %18 = icmp slt i64 %17, %4
+  br i1 %18, label %19, label %25
+
+19:                                               ; preds = %16
+  %20 = getelementptr inbounds i32, ptr %2, i64 %17
+  %21 = load i32, ptr %20, align 4
+  %22 = getelementptr inbounds i32, ptr %3, i64 %17
+  store i32 %21, ptr %22, align 4
+  br label %23
+
+23:                                               ; preds = %19
+  %24 = add nsw i64 %17, 1
+  br label %16
+
+25:                                               ; preds = %16
+  ret void
+}
+
+define dso_local void @strided(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %12, %4
+  %6 = phi i64 [ 0, %4 ], [ %13, %12 ]
+  %7 = icmp slt i64 %6, %3
+  br i1 %7, label %8, label %14
+
+8:                                                ; preds = %5
+  %9 = getelementptr inbounds i32, ptr %0, i64 %6
+  %10 = load i32, ptr %9, align 4
+  %11 = getelementptr inbounds i32, ptr %1, i64 %6
+  store i32 %10, ptr %11, align 4
+  br label %12
+
+12:                                               ; preds = %8
+  %13 = add nsw i64 %6, 1
+  br label %5
+
+14:                                               ; preds = %5
+  br label %15
+
+15:                                               ; preds = %23, %14
+  %16 = phi i64 [ 0, %14 ], [ %24, %23 ]
+  %17 = icmp slt i64 %16, %3
+  br i1 %17, label %18, label %25
+
+18:                                               ; preds = %15
+  %19 = mul nsw i64 %16, 2
+  %20 = getelementptr inbounds i32, ptr %0, i64 %19
+  %21 = load i32, ptr %20, align 4
+  %22 = getelementptr inbounds i32, ptr %2, i64 %16
+  store i32 %21, ptr %22, align 4
+  br label %23
+
+23:                                               ; preds = %18
+  %24 = add nsw i64 %16, 1
+  br label %15
+
+25:                                               ; preds = %15
+  ret void
+}
@@ -0,0 +1,30 @@
+// Input di LoopFusion con trip count diversi: in longer e shorter i loop
+// differiscono di 3 iterazioni, la parte comune viene fusa e le iterazioni in
+// più finiscono in un loop epilogo; in far la differenza supera
+// -loopfusion-max-trip-count-difference=4 e i loop restano separati
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion -loopfusion-max-trip-count-difference=4 test/LoopFusionEpilogue.ll -o test/LoopFusionEpilogue.opt.bc
+//
+void longer(int *restrict a, int *restrict b, int *restrict c) {
+	for (int i = 0; i < 103; i++)
+		a[i] = c[i] * 3;
+
+	for (int i = 0; i < 100; i++)
+		b[i] = c[i] + 11;
+}
+
+void shorter(int *restrict a, int *restrict b, int *restrict c) {
+	for (int i = 0; i < 100; i++)
+		a[i] = c[i] * 3;
+
+	for (int i = 0; i < 103; i++)
+		b[i] = c[i] + 11;
+}
+
+void far(int *restrict a, int *restrict b, int *restrict c) {
+	for (int i = 0; i < 120; i++)
+		a[i] = c[i] * 3;
+
+	for (int i = 0; i < 100; i++)
+		b[i] = c[i] + 11;
+}
@@ -0,0 +1,142 @@
+; ModuleID = 'test/LoopFusionEpilogue.c'
+source_filename = "test/LoopFusionEpilogue.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @longer(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2) {
+  br label %4
+
+4:                                                ; preds = %13, %3
+  %5 = phi i32 [ 0, %3 ], [ %14, %13 ]
+  %6 = icmp slt i32 %5, 103
+  br i1 %6, label %7, label %15
+
+7:                                                ; preds = %4
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %2, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = mul nsw i32 %10, 3
+  %12 = getelementptr inbounds i32, ptr %0, i64 %8
+  store i32 %11, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %7
+  %14 = add nsw i32 %5, 1
+  br label %4
+
+15:                                               ; preds = %4
+  br label %16
+
+16:                                               ; preds = %25, %15
+  %17 = phi i32 [ 0, %15 ], [ %26, %25 ]
+  %18 = icmp slt i32 %17, 100
+  br i1 %18, label %19, label %27
+
+19:                                               ; preds = %16
+  %20 = sext i32 %17 to i64
+  %21 = getelementptr inbounds i32, ptr %2, i64 %20
+  %22 = load i32, ptr %21, align 4
+  %23 = add nsw i32 %22, 11
+  %24 = getelementptr inbounds i32, ptr %1, i64 %20
+  store i32 %23, ptr %24, align 4
+  br label %25
+
+25:                                               ; preds = %19
+  %26 = add nsw i32 %17, 1
+  br label %16
+
+27:                                               ; preds = %16
+  ret void
+}
+
+define dso_local void @shorter(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2) {
+  br label %4
+
+4:                                                ; preds = %13, %3
+  %5 = phi i32 [ 0, %3 ], [ %14, %13 ]
+  %6 = icmp slt i32 %5, 100
+  br i1 %6, label %7, label %15
+
+7:                                                ; preds = %4
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %2, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = mul nsw i32 %10, 3
+  %12 = getelementptr inbounds i32, ptr %0, i64 %8
+  store i32 %11, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %7
+  %14 = add nsw i32 %5, 1
+  br label %4
+
+15:                                               ; preds = %4
+  br label %16
+
+16:                                               ; preds = %25, %15
+  %17 = phi i32 [ 0, %15 ], [ %26, %25 ]
+  %18 = icmp slt i32 %17, 103
+  br i1 %18, label %19, label %27
+
+19:                                               ; preds = %16
+  %20 = sext i32 %17 to i64
+  %21 = getelementptr inbounds i32, ptr %2, i64 %20
+  %22 = load i32, ptr %21, align 4
+  %23 = add nsw i32 %22, 11
+  %24 = getelementptr inbounds i32, ptr %1, i64 %20
+  store i32 %23, ptr %24, align 4
+  br label %25
+
+25:                                               ; preds = %19
+  %26 = add nsw i32 %17, 1
+  br label %16
+
+27:                                               ; preds = %16
+  ret void
+}
+
+define dso_local void @far(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2) {
+  br label %4
+
+4:                                                ; preds = %13, %3
+  %5 = phi i32 [ 0, %3 ], [ %14, %13 ]
+  %6 = icmp slt i32 %5, 120
+  br i1 %6, label %7, label %15
+
+7:                                                ; preds = %4
+  %8 = sext i32 %5 to i64
+  %9 = getelementptr inbounds i32, ptr %2, i64 %8
+  %10 = load i32, ptr %9, align 4
+  %11 = mul nsw i32 %10, 3
+  %12 = getelementptr inbounds i32, ptr %0, i64 %8
+  store i32 %11, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %7
+  %14 = add nsw i32 %5, 1
+  br label %4
+
+15:                                               ; preds = %4
+  br label %16
+
+16:                                               ; preds = %25, %15
+  %17 = phi i32 [ 0, %15 ], [ %26, %25 ]
+  %18 = icmp slt i32 %17, 100
+  br i1 %18, label %19, label %27
+
+19:                                               ; preds = %16
+  %20 = sext i32 %17 to i64
+  %21 = getelementptr inbounds i32, ptr %2, i64 %20
+  %22 = load i32, ptr %21, align 4
+  %23 = add nsw i32 %22, 11
+  %24 = getelementptr inbounds i32, ptr %1, i64 %20
+  store i32 %23, ptr %24, align 4
+  br label %25
+
+25:                                               ; preds = %19
+  %26 = add nsw i32 %17, 1
+  br label %16
+
+27:                                               ; preds = %16
+  ret void
+}
@@ -0,0 +1,12 @@
+// Input di LoopFusion con -loopfusion-ignore-cost-model: la fusione di strided
+// non è conveniente (L2 non è vettorizzabile) ma è legale e viene eseguita
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion -loopfusion-ignore-cost-model test/LoopFusionIgnoreCost.ll -o test/LoopFusionIgnoreCost.opt.bc
+//
+void strided(int *restrict a, int *restrict b, int *restrict c, long n) {
+	for (long i = 0; i < n; i++)
+		b[i] = a[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i * 2];
+}
@@ -0,0 +1,13 @@
+// Input di LoopFusion con induction variable non canoniche: L2 conta da 1 a n,
+// con lo stesso numero di iterazioni di L1; k viene riscritta come i + 1 nel
+// loop fuso
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopFusionIndVars.ll -o test/LoopFusionIndVars.opt.bc
+//
+void shifted(int *restrict a, int *restrict b, int n) {
+	for (int i = 0; i < n; i++)
+		a[i] = i * 3;
+
+	for (int k = 1; k <= n; k++)
+		b[k - 1] = a[k - 1] + k;
+}
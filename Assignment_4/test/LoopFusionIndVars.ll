@@ -0,0 +1,49 @@
+; ModuleID = 'test/LoopFusionIndVars.c'
+source_filename = "test/LoopFusionIndVars.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @shifted(ptr noalias noundef %0, ptr noalias noundef %1, i32 noundef %2) {
+  br label %4
+
+4:                                                ; preds = %11, %3
+  %5 = phi i32 [ 0, %3 ], [ %12, %11 ]
+  %6 = icmp slt i32 %5, %2
+  br i1 %6, label %7, label %13
+
+7:                                                ; preds = %4
+  %8 = mul nsw i32 %5, 3
+  %9 = sext i32 %5 to i64
+  %10 = getelementptr inbounds i32, ptr %0, i64 %9
+  store i32 %8, ptr %10, align 4
+  br label %11
+
+11:                                               ; preds = %7
+  %12 = add nsw i32 %5, 1
+  br label %4
+
+13:                                               ; preds = %4
+  br label %14
+
+14:                                               ; preds = %24, %13
+  %15 = phi i32 [ 1, %13 ], [ %25, %24 ]
+  %16 = icmp sle i32 %15, %2
+  br i1 %16, label %17, label %26
+
+17:                                               ; preds = %14
+  %18 = sub nsw i32 %15, 1
+  %19 = sext i32 %18 to i64
+  %20 = getelementptr inbounds i32, ptr %0, i64 %19
+  %21 = load i32, ptr %20, align 4
+  %22 = add nsw i32 %21, %15
+  %23 = getelementptr inbounds i32, ptr %1, i64 %19
+  store i32 %22, ptr %23, align 4
+  br label %24
+
+24:                                               ; preds = %17
+  %25 = add nsw i32 %15, 1
+  br label %14
+
+26:                                               ; preds = %14
+  ret void
+}
@@ -0,0 +1,16 @@
+// Input di LoopFusion con codice fra i due loop: x + 7 serve a L2 e viene
+// spostato prima di L1, la divisione (che può fallire) e la store su c non
+// servono ai loop e vengono spostate dopo L2; poi i loop sono adiacenti
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopFusionIntervening.ll -o test/LoopFusionIntervening.opt.bc
+//
+void gap(int *restrict a, int *restrict b, int *restrict c, int n, unsigned x, unsigned y) {
+	for (int i = 0; i < n; i++)
+		a[i] = i;
+
+	*c = x / y;
+	int t = x + 7;
+
+	for (int i = 0; i < n; i++)
+		b[i] = a[i] + t;
+}
@@ -0,0 +1,50 @@
+; ModuleID = 'test/LoopFusionIntervening.c'
+source_filename = "test/LoopFusionIntervening.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @gap(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i32 noundef %3, i32 noundef %4, i32 noundef %5) {
+  br label %7
+
+7:                                                ; preds = %13, %6
+  %8 = phi i32 [ 0, %6 ], [ %14, %13 ]
+  %9 = icmp slt i32 %8, %3
+  br i1 %9, label %10, label %15
+
+10:                                               ; preds = %7
+  %11 = sext i32 %8 to i64
+  %12 = getelementptr inbounds i32, ptr %0, i64 %11
+  store i32 %8, ptr %12, align 4
+  br label %13
+
+13:                                               ; preds = %10
+  %14 = add nsw i32 %8, 1
+  br label %7
+
+15:                                               ; preds = %7
+  %16 = udiv i32 %4, %5
+  %17 = add nsw i32 %4, 7
+  store i32 %16, ptr %2, align 4
+  br label %18
+
+18:                                               ; preds = %27, %15
+  %19 = phi i32 [ 0, %15 ], [ %28, %27 ]
+  %20 = icmp slt i32 %19, %3
+  br i1 %20, label %21, label %29
+
+21:                                               ; preds = %18
+  %22 = sext i32 %19 to i64
+  %23 = getelementptr inbounds i32, ptr %0, i64 %22
+  %24 = load i32, ptr %23, align 4
+  %25 = add nsw i32 %24, %17
+  %26 = getelementptr inbounds i32, ptr %1, i64 %22
+  store i32 %25, ptr %26, align 4
+  br label %27
+
+27:                                               ; preds = %21
+  %28 = add nsw i32 %19, 1
+  br label %18
+
+29:                                               ; preds = %18
+  ret void
+}
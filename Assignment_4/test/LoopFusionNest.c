@@ -0,0 +1,14 @@
+// Input di LoopFusion con loop annidati: i due loop esterni vengono fusi e poi
+// anche i loop interni, che ora sono adiacenti nel corpo del loop fuso
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopFusionNest.ll -o test/LoopFusionNest.opt.bc
+//
+void sweep(int (*restrict a)[100], int (*restrict b)[100], int (*restrict c)[100], long n) {
+	for (long i = 0; i < n; i++)
+		for (long j = 0; j < 100; j++)
+			a[i][j] = c[i][j] + 1;
+
+	for (long k = 0; k < n; k++)
+		for (long l = 0; l < 100; l++)
+			b[k][l] = c[k][l] * 2;
+}
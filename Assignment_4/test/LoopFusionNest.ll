@@ -0,0 +1,72 @@
+; ModuleID = 'test/LoopFusionNest.c'
+source_filename = "test/LoopFusionNest.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @sweep(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3) {
+  br label %5
+
+5:                                                ; preds = %19, %4
+  %6 = phi i64 [ 0, %4 ], [ %20, %19 ]
+  %7 = icmp slt i64 %6, %3
+  br i1 %7, label %8, label %21
+
+8:                                                ; preds = %5
+  br label %9
+
+9:                                                ; preds = %17, %8
+  %10 = phi i64 [ 0, %8 ], [ %18, %17 ]
+  %11 = icmp slt i64 %10, 100
+  br i1 %11, label %12, label %19
+
+12:                                               ; preds = %9
+  %13 = getelementptr inbounds [100 x i32], ptr %2, i64 %6, i64 %10
+  %14 = load i32, ptr %13, align 4
+  %15 = add nsw i32 %14, 1
+  %16 = getelementptr inbounds [100 x i32], ptr %0, i64 %6, i64 %10
+  store i32 %15, ptr %16, align 4
+  br label %17
+
+17:                                               ; preds = %12
+  %18 = add nsw i64 %10, 1
+  br label %9
+
+19:                                               ; preds = %9
+  %20 = add nsw i64 %6, 1
+  br label %5
+
+21:                                               ; preds = %5
+  br label %22
+
+22:                                               ; preds = %36, %21
+  %23 = phi i64 [ 0, %21 ], [ %37, %36 ]
+  %24 = icmp slt i64 %23, %3
+  br i1 %24, label %25, label %38
+
+25:                                               ; preds = %22
+  br label %26
+
+26:                                               ; preds = %34, %25
+  %27 = phi i64 [ 0, %25 ], [ %35, %34 ]
+  %28 = icmp slt i64 %27, 100
+  br i1 %28, label %29, label %36
+
+29:                                               ; preds = %26
+  %30 = getelementptr inbounds [100 x i32], ptr %2, i64 %23, i64 %27
+  %31 = load i32, ptr %30, align 4
+  %32 = mul nsw i32 %31, 2
+  %33 = getelementptr inbounds [100 x i32], ptr %1, i64 %23, i64 %27
+  store i32 %32, ptr %33, align 4
+  br label %34
+
+34:                                               ; preds = %29
+  %35 = add nsw i64 %27, 1
+  br label %26
+
+36:                                               ; preds = %26
+  %37 = add nsw i64 %23, 1
+  br label %22
+
+38:                                               ; preds = %22
+  ret void
+}
@@ -0,0 +1,24 @@
+// Input di LoopFusion con distanza simbolica: L1 scrive a[i + k] e L2 legge a[i].
+// In guarded k >= 0 è garantito dalla guardia, la distanza non è negativa e i
+// loop vengono fusi; in unguarded k può essere negativo e la fusione è rifiutata
+//
+//	opt -load-pass-plugin=build/LoopFusion.so -passes=LoopFusion test/LoopFusionSymbolic.ll -o test/LoopFusionSymbolic.opt.bc
+//
+void guarded(char *restrict a, char *restrict b, char *restrict c, long n, long k) {
+	if (k < 0)
+		return;
+
+	for (long i = 0; i < n; i++)
+		a[i + k] = b[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i];
+}
+
+void unguarded(char *restrict a, char *restrict b, char *restrict c, long n, long k) {
+	for (long i = 0; i < n; i++)
+		a[i + k] = b[i];
+
+	for (long i = 0; i < n; i++)
+		c[i] = a[i];
+}
@@ -0,0 +1,97 @@
+; ModuleID = 'test/LoopFusionSymbolic.c'
+source_filename = "test/LoopFusionSymbolic.c"
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-redhat-linux-gnu"
+
+define dso_local void @guarded(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3, i64 noundef %4) {
+  %6 = icmp slt i64 %4, 0
+  br i1 %6, label %29, label %7
+
+7:                                                ; preds = %5
+  br label %8
+
+8:                                                ; preds = %16, %7
+  %9 = phi i64 [ 0, %7 ], [ %17, %16 ]
+  %10 = icmp slt i64 %9, %3
+  br i1 %10, label %11, label %18
+
+11:                                               ; preds = %8
+  %12 = getelementptr inbounds i8, ptr %1, i64 %9
+  %13 = load i8, ptr %12, align 1
+  %14 = add nsw i64 %9, %4
+  %15 = getelementptr inbounds i8, ptr %0, i64 %14
+  store i8 %13, ptr %15, align 1
+  br label %16
+
+16:                                               ; preds = %11
+  %17 = add nsw i64 %9, 1
+  br label %8
+
+18:                                               ; preds = %8
+  br label %19
+
+19:                                               ; preds = %26, %18
+  %20 = phi i64 [ 0, %18 ], [ %27, %26 ]
+  %21 = icmp slt i64 %20, %3
+  br i1 %21, label %22, label %28
+
+22:                                               ; preds = %19
+  %23 = getelementptr inbounds i8, ptr %0, i64 %20
+  %24 = load i8, ptr %23, align 1
+  %25 = getelementptr inbounds i8, ptr %2, i64 %20
+  store i8 %24, ptr %25, align 1
+  br label %26
+
+26:                                               ; preds = %22
+  %27 = add nsw i64 %20, 1
+  br label %19
+
+28:                                               ; preds = %19
+  br label %29
+
+29:                                               ; preds = %28, %5
+  ret void
+}
+
+define dso_local void @unguarded(ptr noalias noundef %0, ptr noalias noundef %1, ptr noalias noundef %2, i64 noundef %3, i64 noundef %4) {
+  br label %6
+
+6:                                                ; preds = %14, %5
+  %7 = phi i64 [ 0, %5 ], [ %15, %14 ]
+  %8 = icmp slt i64 %7, %3
+  br i1 %8, label %9, label %16
+
+9:                                                ; preds = %6
+  %10 = getelementptr inbounds i8, ptr %1, i64 %7
+  %11 = load i8, ptr %10, align 1
+  %12 = add nsw i64 %7, %4
+  %13 = getelementptr inbounds i8, ptr %0, i64 %12
+  store i8 %11, ptr %13, align 1
+  br label %14
+
+14:                                               ; preds = %9
+  %15 = add nsw i64 %7, 1
+  br label %6
+
+16:                                               ; preds = %6
+  br label %17
+
+17:                                               ; preds = %24, %16
+  %18 = phi i64 [ 0, %16 ], [ %25, %24 ]
+  %19 = icmp slt i64 %18, %3
+  br i1 %19, label %20, label %26
+
+20:                                               ; preds = %17
+  %21 = getelementptr inbounds i8, ptr %0, i64 %18
+  %22 = load i8, ptr %21, align 1
+  %23 = getelementptr inbounds i8, ptr %2, i64 %18
+  store i8 %22, ptr %23, align 1
+  br label %24
+
+24:                                               ; preds = %20
+  %25 = add nsw i64 %18, 1
+  br label %17
+
+26:                                               ; preds = %17
+  ret void
+}